@@ -0,0 +1,170 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "AutoSizeCommentsBoundsCache.h"
+
+#include "AutoSizeCommentsContainment.h"
+#include "AutoSizeCommentsGraphNode.h"
+#include "AutoSizeCommentsModule.h"
+#include "AutoSizeCommentsSettings.h"
+#include "AutoSizeCommentsUtils.h"
+#include "EdGraphNode_Comment.h"
+#include "SCommentBubble.h"
+#include "SGraphPanel.h"
+
+FSlateRect FASCBoundsCache::GetNodeBounds(TSharedPtr<SGraphPanel> GraphPanel, UEdGraphNode* Node)
+{
+	if (!Node)
+	{
+		return FSlateRect();
+	}
+
+	const bool bIsDirty = DirtyNodes.Contains(Node);
+	if (!bIsDirty)
+	{
+		if (const FSlateRect* Bounds = NodeBounds.Find(Node))
+		{
+			return *Bounds;
+		}
+	}
+
+	TSharedPtr<SGraphNode> NodeWidget = FASCUtils::GetGraphNode(GraphPanel, Node);
+	if (!NodeWidget.IsValid())
+	{
+		// the widget hasn't been created yet, don't cache this
+		return FSlateRect::FromPointAndExtent(FASCVector2(Node->NodePosX, Node->NodePosY), FASCVector2(300, 150));
+	}
+
+	const FSlateRect Bounds = CalculateNodeBounds(*NodeWidget);
+
+	// dirty nodes are stored by UpdateNodeBounds so the comments containing them are updated too
+	if (!bIsDirty)
+	{
+		NodeBounds.Add(Node, Bounds);
+	}
+
+	return Bounds;
+}
+
+void FASCBoundsCache::UpdateNodeBounds(SGraphNode& NodeWidget, const FASCCommentContainment& Containment)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCBoundsCache::UpdateNodeBounds"), STAT_ASC_BoundsCache_UpdateNodeBounds, STATGROUP_AutoSizeComments);
+
+	UEdGraphNode* Node = NodeWidget.GetNodeObj();
+	if (!Node)
+	{
+		return;
+	}
+
+	DirtyNodes.Remove(Node);
+
+	const FSlateRect NewBounds = CalculateNodeBounds(NodeWidget);
+	FSlateRect* OldBounds = NodeBounds.Find(Node);
+	if (OldBounds && *OldBounds == NewBounds)
+	{
+		return;
+	}
+
+	// comments may skip a member comment which contains them, so they are always recalculated
+	const bool bCanGrowInPlace = OldBounds && !Node->IsA<UEdGraphNode_Comment>();
+
+	for (UEdGraphNode_Comment* Comment : Containment.GetContainingComments(Node))
+	{
+		FSlateRect* Bounds = CommentBounds.Find(Comment);
+		if (!Bounds)
+		{
+			continue;
+		}
+
+		// the other members define the edges, so only the new bounds need to be added
+		if (bCanGrowInPlace && IsInsideEdges(*OldBounds, *Bounds))
+		{
+			*Bounds = Bounds->Expand(NewBounds);
+		}
+		else
+		{
+			CommentBounds.Remove(Comment);
+		}
+	}
+
+	NodeBounds.Add(Node, NewBounds);
+}
+
+bool FASCBoundsCache::FindCommentBounds(UEdGraphNode_Comment* Comment, FSlateRect& OutBounds) const
+{
+	if (const FSlateRect* Bounds = CommentBounds.Find(Comment))
+	{
+		OutBounds = *Bounds;
+		return true;
+	}
+
+	return false;
+}
+
+void FASCBoundsCache::RemoveInvalidNodes()
+{
+	for (auto Iter = NodeBounds.CreateIterator(); Iter; ++Iter)
+	{
+		if (!Iter.Key().IsValid())
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+
+	for (auto Iter = CommentBounds.CreateIterator(); Iter; ++Iter)
+	{
+		if (!Iter.Key().IsValid())
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+
+	for (auto Iter = DirtyNodes.CreateIterator(); Iter; ++Iter)
+	{
+		if (!Iter->IsValid())
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+}
+
+FSlateRect FASCBoundsCache::CalculateNodeBounds(SGraphNode& NodeWidget)
+{
+	UEdGraphNode* Node = NodeWidget.GetNodeObj();
+
+	FASCVector2 Pos = FASCUtils::GetNodePos(&NodeWidget);
+	FASCVector2 Size;
+
+	// BlueprintAssist will write into NodeWidth and NodeHeight for non-resizable nodes
+	if (Node->bCanResizeNode || (UAutoSizeCommentsSettings::Get().bUseNodeSizeForBounds && FAutoSizeCommentsModule::IsBlueprintAssistEnabled() && Node->NodeWidth != 0 && Node->NodeHeight != 0))
+	{
+		Size.X = Node->NodeWidth;
+		Size.Y = Node->NodeHeight;
+	}
+	else
+	{
+		Size = NodeWidget.GetDesiredSize();
+	}
+
+	if (UAutoSizeCommentsSettings::Get().bUseCommentBubbleBounds && Node->bCommentBubbleVisible)
+	{
+		if (SNodePanel::SNode::FNodeSlot* CommentSlot = NodeWidget.GetSlot(ENodeZone::TopCenter))
+		{
+			TSharedPtr<SCommentBubble> LocalCommentBubble = StaticCastSharedRef<SCommentBubble>(CommentSlot->GetWidget());
+
+			if (LocalCommentBubble.IsValid() && LocalCommentBubble->IsBubbleVisible())
+			{
+				FASCVector2 CommentBubbleSize = LocalCommentBubble->GetDesiredSize();
+				Pos.Y -= CommentBubbleSize.Y;
+				Size.Y += CommentBubbleSize.Y;
+				Size.X = FMath::Max(Size.X, CommentBubbleSize.X);
+			}
+		}
+	}
+
+	return FSlateRect::FromPointAndExtent(Pos, Size);
+}
+
+bool FASCBoundsCache::IsInsideEdges(const FSlateRect& Inner, const FSlateRect& Outer)
+{
+	return Inner.Left > Outer.Left && Inner.Top > Outer.Top && Inner.Right < Outer.Right && Inner.Bottom < Outer.Bottom;
+}
@@ -0,0 +1,155 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "AutoSizeCommentsBroadphase.h"
+
+#include "AutoSizeCommentsGraphNode.h"
+#include "EdGraphNode_Comment.h"
+#include "Algo/BinarySearch.h"
+#include "EdGraph/EdGraph.h"
+
+void FASCCommentBroadphase::Update(UEdGraph* Graph)
+{
+	if (LastBuildFrame == GFrameCounter)
+	{
+		return;
+	}
+
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCCommentBroadphase::Update"), STAT_ASC_CommentBroadphase_Update, STATGROUP_AutoSizeComments);
+
+	LastBuildFrame = GFrameCounter;
+	Entries.Reset();
+	MaxWidth = 0.0f;
+
+	if (!Graph)
+	{
+		return;
+	}
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node);
+		if (!Comment || SAutoSizeCommentsGraphNode::IsHeaderComment(Comment))
+		{
+			continue;
+		}
+
+		const FSlateRect Bounds = SAutoSizeCommentsGraphNode::GetCommentBounds(Comment);
+		MaxWidth = FMath::Max(MaxWidth, Bounds.Right - Bounds.Left);
+		Entries.Add(FEntry{ Comment, Bounds });
+	}
+
+	Entries.Sort([](const FEntry& A, const FEntry& B) { return A.Bounds.Left < B.Bounds.Left; });
+}
+
+void FASCCommentBroadphase::QueryOverlapEntries(const FSlateRect& Bounds, const UEdGraphNode_Comment* IgnoreComment, TArray<int32>& OutEntryIndices) const
+{
+	// no comment starting before this can reach the query
+	const float MinLeft = Bounds.Left - MaxWidth;
+	const int32 StartIndex = Algo::LowerBoundBy(Entries, MinLeft, [](const FEntry& Entry) { return Entry.Bounds.Left; });
+
+	for (int32 EntryIndex = StartIndex; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		const FEntry& Entry = Entries[EntryIndex];
+		if (Entry.Bounds.Left >= Bounds.Right)
+		{
+			break;
+		}
+
+		UEdGraphNode_Comment* Comment = Entry.Comment.Get();
+		if (Comment && Comment != IgnoreComment && FSlateRect::DoRectanglesIntersect(Entry.Bounds, Bounds))
+		{
+			OutEntryIndices.Add(EntryIndex);
+		}
+	}
+}
+
+bool FASCCommentBroadphase::FindFreeOffset(const FSlateRect& Bounds, const UEdGraphNode_Comment* IgnoreComment, FASCVector2& OutOffset) const
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCCommentBroadphase::FindFreeOffset"), STAT_ASC_CommentBroadphase_FindFreeOffset, STATGROUP_AutoSizeComments);
+
+	// gap left between the bounds and the comment they were pushed past
+	static constexpr float Padding = 10.0f;
+
+	// stop searching in very crowded graphs, the comment is left where it is
+	static constexpr int32 MaxCandidates = 256;
+
+	TArray<FASCVector2> Candidates;
+	Candidates.Add(FASCVector2::ZeroVector);
+
+	TSet<FIntPoint> VisitedOffsets;
+	TArray<int32> Overlaps;
+
+	while (Candidates.Num() && VisitedOffsets.Num() < MaxCandidates)
+	{
+		// test the nearest candidate, ties are broken by position so the result doesn't depend on the order they were found
+		int32 NearestIndex = 0;
+		for (int32 i = 1; i < Candidates.Num(); ++i)
+		{
+			const FASCVector2& Candidate = Candidates[i];
+			const FASCVector2& Nearest = Candidates[NearestIndex];
+			const float CandidateDistSq = Candidate.SizeSquared();
+			const float NearestDistSq = Nearest.SizeSquared();
+			if (CandidateDistSq < NearestDistSq ||
+				(CandidateDistSq == NearestDistSq && (Candidate.X < Nearest.X || (Candidate.X == Nearest.X && Candidate.Y < Nearest.Y))))
+			{
+				NearestIndex = i;
+			}
+		}
+
+		const FASCVector2 Offset = Candidates[NearestIndex];
+		Candidates.RemoveAtSwap(NearestIndex);
+
+		bool bAlreadyVisited = false;
+		VisitedOffsets.Add(FIntPoint(FMath::RoundToInt(Offset.X), FMath::RoundToInt(Offset.Y)), &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			continue;
+		}
+
+		const FSlateRect TestBounds = Bounds.OffsetBy(Offset);
+
+		Overlaps.Reset();
+		QueryOverlapEntries(TestBounds, IgnoreComment, Overlaps);
+
+		if (Overlaps.Num() == 0)
+		{
+			OutOffset = Offset;
+			return true;
+		}
+
+		const FASCVector2 TestSize = TestBounds.GetSize();
+		// push past the same bounds the overlap was tested against, which may include comments moved this frame
+		for (int32 EntryIndex : Overlaps)
+		{
+			const FSlateRect& OtherBounds = Entries[EntryIndex].Bounds;
+			Candidates.Add(FASCVector2(OtherBounds.Left - TestSize.X - Padding - Bounds.Left, Offset.Y));
+			Candidates.Add(FASCVector2(OtherBounds.Right + Padding - Bounds.Left, Offset.Y));
+			Candidates.Add(FASCVector2(Offset.X, OtherBounds.Top - TestSize.Y - Padding - Bounds.Top));
+			Candidates.Add(FASCVector2(Offset.X, OtherBounds.Bottom + Padding - Bounds.Top));
+		}
+	}
+
+	return false;
+}
+
+void FASCCommentBroadphase::UpdateComment(UEdGraphNode_Comment* Comment, const FSlateRect& NewBounds)
+{
+	const int32 EntryIndex = Entries.IndexOfByPredicate([Comment](const FEntry& Entry) { return Entry.Comment.Get() == Comment; });
+	if (EntryIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FEntry Entry = Entries[EntryIndex];
+	Entries.RemoveAt(EntryIndex);
+
+	Entry.Bounds = NewBounds;
+	MaxWidth = FMath::Max(MaxWidth, Entry.Bounds.Right - Entry.Bounds.Left);
+	AddSorted(MoveTemp(Entry));
+}
+
+void FASCCommentBroadphase::AddSorted(FEntry&& Entry)
+{
+	const int32 InsertIndex = Algo::UpperBoundBy(Entries, Entry.Bounds.Left, [](const FEntry& Other) { return Other.Bounds.Left; });
+	Entries.Insert(MoveTemp(Entry), InsertIndex);
+}
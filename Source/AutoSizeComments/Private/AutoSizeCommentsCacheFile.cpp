@@ -10,19 +10,39 @@
 #include "EdGraphNode_Comment.h"
 #include "GeneralProjectSettings.h"
 #include "JsonObjectConverter.h"
+#include "Async/Async.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/AssetRegistryState.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraph/EdGraphNode.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFileManager.h"
 #include "Interfaces/IPluginManager.h"
 #include "Misc/CoreDelegates.h"
 #include "Misc/FileHelper.h"
 #include "Misc/LazySingleton.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
 #include "UObject/MetaData.h"
 
 static FName NAME_ASC_GRAPH_DATA = FName("ASCGraphData");
 
+static const TCHAR* BinaryCacheExtension = TEXT("bin");
+static constexpr uint32 BinaryCacheMagic = 0x43435341; // "ASCC"
+static constexpr int32 BinaryCacheVersion = 1;
+
+static const TCHAR* JournalExtension = TEXT("journal");
+static constexpr uint32 JournalMagic = 0x4A435341; // "ASCJ"
+static constexpr int32 JournalVersion = 1;
+
+enum class EASCJournalOp : uint8
+{
+	ResetGraph,
+	SetComment,
+	RemoveComment,
+};
+
 FAutoSizeCommentsCacheFile& FAutoSizeCommentsCacheFile::Get()
 {
 	return TLazySingleton<FAutoSizeCommentsCacheFile>::Get();
@@ -40,7 +60,7 @@ void FAutoSizeCommentsCacheFile::Init()
 		AssetRegistryModule->Get().OnFilesLoaded().AddRaw(this, &FAutoSizeCommentsCacheFile::LoadCacheFromFile);
 	}
 
-	FCoreDelegates::OnPreExit.AddRaw(this, &FAutoSizeCommentsCacheFile::SaveCacheToFile);
+	FCoreDelegates::OnPreExit.AddRaw(this, &FAutoSizeCommentsCacheFile::SaveCacheOnExit);
 	FCoreUObjectDelegates::OnAssetLoaded.AddRaw(this, &FAutoSizeCommentsCacheFile::OnObjectLoaded);
 }
 
@@ -53,6 +73,8 @@ void FAutoSizeCommentsCacheFile::Cleanup()
 
 	FCoreDelegates::OnPreExit.RemoveAll(this);
 	FCoreUObjectDelegates::OnAssetLoaded.RemoveAll(this);
+
+	WaitForPendingSave();
 }
 
 void FAutoSizeCommentsCacheFile::LoadCacheFromFile()
@@ -64,79 +86,507 @@ void FAutoSizeCommentsCacheFile::LoadCacheFromFile()
 
 	bHasLoaded = true;
 
-	const FString CachePath = GetCachePath();
-	const FString OldCachePath = GetAlternateCachePath();
+	// only index the package files, they are read when the package's graph is first opened
+	if (!FindPackageCacheFiles(UnloadedPackageFiles))
+	{
+		// migrate from the single cache file if the package cache hasn't been written yet
+		bRequiresPackageCacheMigration = ReadCacheFile(CacheData);
+	}
 
-	FString FileData;
-	if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*CachePath))
+	CleanupFiles();
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.OnFilesLoaded().RemoveAll(this);
+}
+
+FASCCacheData FAutoSizeCommentsCacheFile::CreateCacheFromFile()
+{
+	FASCCacheData NewCacheData;
+
+	TMap<FName, FString> PackageFiles;
+	if (FindPackageCacheFiles(PackageFiles))
+	{
+		for (const auto& PackageFile : PackageFiles)
+		{
+			FASCCacheData PackageCacheData;
+			if (LoadCacheDataFromPath(PackageFile.Value, PackageCacheData))
+			{
+				NewCacheData.PackageData.Append(MoveTemp(PackageCacheData.PackageData));
+			}
+		}
+	}
+	else
 	{
-		FFileHelper::LoadFileToString(FileData, *CachePath);
+		ReadCacheFile(NewCacheData);
+	}
 
-		if (FJsonObjectConverter::JsonObjectStringToUStruct(FileData, &CacheData, 0, 0))
+	return NewCacheData;
+}
+
+bool FAutoSizeCommentsCacheFile::FindPackageCacheFiles(TMap<FName, FString>& OutPackageFiles)
+{
+	const FString PackageCacheDir = GetPackageCacheDirectory();
+	if (!FPlatformFileManager::Get().GetPlatformFile().DirectoryExists(*PackageCacheDir))
+	{
+		return false;
+	}
+
+	TArray<FString> FileNames;
+	IFileManager::Get().FindFiles(FileNames, *(PackageCacheDir / TEXT("*")), true, false);
+
+	// add the selected format last so it takes priority if the format was changed
+	const FString SelectedExtension = GetCacheFileExtension();
+	FileNames.StableSort([&SelectedExtension](const FString& A, const FString& B)
+	{
+		return FPaths::GetExtension(A) != SelectedExtension && FPaths::GetExtension(B) == SelectedExtension;
+	});
+
+	for (const FString& FileName : FileNames)
+	{
+		const FString Extension = FPaths::GetExtension(FileName);
+		if (Extension == TEXT("json") || Extension == BinaryCacheExtension)
 		{
-			UE_LOG(LogAutoSizeComments, Log, TEXT("Loaded auto size comments cache: %s"), *GetCachePath(true));
+			OutPackageFiles.Add(GetPackageNameFromCachePath(FileName), PackageCacheDir / FileName);
 		}
-		else
+		else if (Extension == JournalExtension)
 		{
-			UE_LOG(LogAutoSizeComments, Log, TEXT("Failed to load auto size comments cache: %s"), *GetCachePath(true));
+			// the package only has a journal, it is replayed on top of an empty cache
+			const FName PackageName = GetPackageNameFromCachePath(FileName);
+			if (!OutPackageFiles.Contains(PackageName))
+			{
+				OutPackageFiles.Add(PackageName, PackageCacheDir / FPaths::SetExtension(FileName, SelectedExtension));
+			}
 		}
 	}
-	else if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*OldCachePath))
+
+	UE_LOG(LogAutoSizeComments, Log, TEXT("Found %d package cache files in %s"), OutPackageFiles.Num(), *FPaths::ConvertRelativePathToFull(PackageCacheDir));
+	return true;
+}
+
+FASCPackageData& FAutoSizeCommentsCacheFile::FindOrLoadPackageData(FName PackageName)
+{
+	FString PackageFile;
+	if (UnloadedPackageFiles.RemoveAndCopyValue(PackageName, PackageFile))
 	{
-		FFileHelper::LoadFileToString(FileData, *OldCachePath);
+		const double StartTime = FPlatformTime::Seconds();
 
-		if (FJsonObjectConverter::JsonObjectStringToUStruct(FileData, &CacheData, 0, 0))
+		// the package may only have a journal
+		if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*PackageFile))
 		{
-			UE_LOG(LogAutoSizeComments, Log, TEXT("Loaded auto size comments cache from old cache path: %s"), *GetAlternateCachePath(true));
+			FASCCacheData PackageCacheData;
+			if (LoadCacheDataFromPath(PackageFile, PackageCacheData))
+			{
+				CacheData.PackageData.Append(MoveTemp(PackageCacheData.PackageData));
+			}
+			else
+			{
+				UE_LOG(LogAutoSizeComments, Log, TEXT("Failed to load auto size comments package cache: %s"), *PackageFile);
+			}
 		}
-		else
+
+		// changes written since the last save, fold them into the cache file
+		if (ReplayJournal(GetJournalPath(PackageFile), CacheData.PackageData.FindOrAdd(PackageName)))
 		{
-			UE_LOG(LogAutoSizeComments, Log, TEXT("Failed to load auto size comments cache from old cache path: %s"), *GetAlternateCachePath(true));
+			PackagesRequiringCompaction.Add(PackageName);
 		}
-	}
 
-	CleanupFiles();
+		const double TimeTaken = (FPlatformTime::Seconds() - StartTime) * 1000.0f;
+		UE_LOG(LogAutoSizeComments, Verbose, TEXT("Loaded package cache %s took %6.2fms"), *PackageFile, TimeTaken);
+	}
 
-	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
-	AssetRegistry.OnFilesLoaded().RemoveAll(this);
+	return CacheData.PackageData.FindOrAdd(PackageName);
 }
 
-FASCCacheData FAutoSizeCommentsCacheFile::CreateCacheFromFile()
+bool FAutoSizeCommentsCacheFile::ReadCacheFile(FASCCacheData& OutCacheData)
 {
-	FASCCacheData NewCacheData;
+	const double StartTime = FPlatformTime::Seconds();
 
+	// look for the selected format first, then migrate from a json cache or the cache in the other location
 	const FString CachePath = GetCachePath();
-	const FString OldCachePath = GetAlternateCachePath();
+	const FString AlternateCachePath = GetAlternateCachePath();
+	TArray<FString> CachePaths;
+	CachePaths.AddUnique(CachePath);
+	CachePaths.AddUnique(FPaths::ChangeExtension(CachePath, TEXT("json")));
+	CachePaths.AddUnique(AlternateCachePath);
+	CachePaths.AddUnique(FPaths::ChangeExtension(AlternateCachePath, TEXT("json")));
+
+	for (const FString& Path : CachePaths)
+	{
+		if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*Path))
+		{
+			continue;
+		}
+
+		if (LoadCacheDataFromPath(Path, OutCacheData))
+		{
+			const double TimeTaken = (FPlatformTime::Seconds() - StartTime) * 1000.0f;
+			UE_LOG(LogAutoSizeComments, Log, TEXT("Loaded auto size comments cache: %s took %6.2fms"), *FPaths::ConvertRelativePathToFull(Path), TimeTaken);
+			return true;
+		}
+
+		UE_LOG(LogAutoSizeComments, Log, TEXT("Failed to load auto size comments cache: %s"), *FPaths::ConvertRelativePathToFull(Path));
+		OutCacheData.PackageData.Reset();
+	}
+
+	return false;
+}
+
+bool FAutoSizeCommentsCacheFile::LoadCacheDataFromPath(const FString& Path, FASCCacheData& OutCacheData)
+{
+	if (FPaths::GetExtension(Path) == BinaryCacheExtension)
+	{
+		TArray<uint8> FileData;
+		if (!FFileHelper::LoadFileToArray(FileData, *Path))
+		{
+			return false;
+		}
+
+		FMemoryReader Reader(FileData);
+		return SerializeBinaryCache(Reader, OutCacheData);
+	}
 
 	FString FileData;
-	if (FPlatformFileManager::Get().GetPlatformFile().FileExists(*CachePath))
+	if (!FFileHelper::LoadFileToString(FileData, *Path))
 	{
-		FFileHelper::LoadFileToString(FileData, *CachePath);
+		return false;
+	}
+
+	return FJsonObjectConverter::JsonObjectStringToUStruct(FileData, &OutCacheData, 0, 0);
+}
 
-		if (FJsonObjectConverter::JsonObjectStringToUStruct(FileData, &NewCacheData, 0, 0))
+bool FAutoSizeCommentsCacheFile::SaveCacheDataToPath(const FString& Path, FASCCacheData& InCacheData, bool bPrettyPrintJson)
+{
+	if (FPaths::GetExtension(Path) == BinaryCacheExtension)
+	{
+		TArray<uint8> FileData;
+		FMemoryWriter Writer(FileData);
+		SerializeBinaryCache(Writer, InCacheData);
+		return FFileHelper::SaveArrayToFile(FileData, *Path);
+	}
+
+	FString JsonAsString;
+	FJsonObjectConverter::UStructToJsonObjectString(InCacheData, JsonAsString, 0, 0, 0, nullptr, bPrettyPrintJson);
+	return FFileHelper::SaveStringToFile(JsonAsString, *Path);
+}
+
+bool FAutoSizeCommentsCacheFile::SerializeBinaryCache(FArchive& Ar, FASCCacheData& Data)
+{
+	uint32 Magic = BinaryCacheMagic;
+	int32 Version = BinaryCacheVersion;
+	Ar << Magic;
+	Ar << Version;
+
+	if (Ar.IsLoading() && (Magic != BinaryCacheMagic || Version > BinaryCacheVersion))
+	{
+		UE_LOG(LogAutoSizeComments, Warning, TEXT("Unsupported binary comment cache (version %d)"), Version);
+		return false;
+	}
+
+	// package name table
+	TArray<FString> PackageNames;
+	if (Ar.IsSaving())
+	{
+		for (const auto& Package : Data.PackageData)
 		{
-			UE_LOG(LogAutoSizeComments, Log, TEXT("Loaded auto size comments cache: %s"), *GetCachePath(true));
+			PackageNames.Add(Package.Key.ToString());
+		}
+	}
+
+	Ar << PackageNames;
+
+	if (Ar.IsLoading())
+	{
+		Data.PackageData.Reset();
+		Data.PackageData.Reserve(PackageNames.Num());
+	}
+
+	for (const FString& PackageName : PackageNames)
+	{
+		FASCPackageData& PackageData = Data.PackageData.FindOrAdd(FName(*PackageName));
+
+		int32 NumGraphs = PackageData.GraphData.Num();
+		Ar << NumGraphs;
+
+		if (Ar.IsLoading())
+		{
+			for (int32 GraphIndex = 0; GraphIndex < NumGraphs && !Ar.IsError(); ++GraphIndex)
+			{
+				FGuid GraphGuid;
+				Ar << GraphGuid;
+				SerializeBinaryGraphData(Ar, PackageData.GraphData.FindOrAdd(GraphGuid));
+			}
 		}
 		else
 		{
-			UE_LOG(LogAutoSizeComments, Log, TEXT("Failed to load auto size comments cache: %s"), *GetCachePath(true));
+			for (auto& Graph : PackageData.GraphData)
+			{
+				FGuid GraphGuid = Graph.Key;
+				Ar << GraphGuid;
+				SerializeBinaryGraphData(Ar, Graph.Value);
+			}
+		}
+	}
+
+	return !Ar.IsError();
+}
+
+void FAutoSizeCommentsCacheFile::SerializeBinaryGraphData(FArchive& Ar, FASCGraphData& GraphData)
+{
+	int32 NumComments = GraphData.CommentData.Num();
+	Ar << NumComments;
+
+	if (Ar.IsLoading())
+	{
+		GraphData.CommentData.Reserve(NumComments);
+		for (int32 CommentIndex = 0; CommentIndex < NumComments && !Ar.IsError(); ++CommentIndex)
+		{
+			FGuid CommentGuid;
+			Ar << CommentGuid;
+			SerializeBinaryCommentData(Ar, GraphData.CommentData.FindOrAdd(CommentGuid));
 		}
 	}
 	else
 	{
-		FFileHelper::LoadFileToString(FileData, *OldCachePath);
+		for (auto& Comment : GraphData.CommentData)
+		{
+			FGuid CommentGuid = Comment.Key;
+			Ar << CommentGuid;
+			SerializeBinaryCommentData(Ar, Comment.Value);
+		}
+	}
+}
+
+void FAutoSizeCommentsCacheFile::SerializeBinaryCommentData(FArchive& Ar, FASCCommentData& CommentData)
+{
+	uint8 Flags = (CommentData.IsHeader() ? 1 : 0) | (CommentData.HasBeenInitialized() ? 2 : 0);
+	Ar << Flags;
+	Ar << CommentData.NodeGuids;
+
+	CommentData.SetHeader((Flags & 1) != 0);
+	CommentData.SetInitialized((Flags & 2) != 0);
+}
+
+FString FAutoSizeCommentsCacheFile::GetJournalPath(const FString& PackageCachePath)
+{
+	return FPaths::ChangeExtension(PackageCachePath, JournalExtension);
+}
+
+bool FAutoSizeCommentsCacheFile::ReplayJournal(const FString& Path, FASCPackageData& PackageData)
+{
+	TArray<uint8> FileData;
+	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*Path) || !FFileHelper::LoadFileToArray(FileData, *Path))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(FileData);
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+
+	if (Reader.IsError() || Magic != JournalMagic || Version > JournalVersion)
+	{
+		UE_LOG(LogAutoSizeComments, Warning, TEXT("Unsupported comment cache journal: %s"), *Path);
+		return false;
+	}
 
-		if (FJsonObjectConverter::JsonObjectStringToUStruct(FileData, &NewCacheData, 0, 0))
+	int32 NumRecords = 0;
+	while (!Reader.AtEnd())
+	{
+		uint8 Op = 0;
+		FGuid GraphGuid;
+		FGuid CommentGuid;
+		Reader << Op;
+		Reader << GraphGuid;
+		Reader << CommentGuid;
+
+		FASCCommentData NewCommentData;
+		if (static_cast<EASCJournalOp>(Op) == EASCJournalOp::SetComment)
 		{
-			UE_LOG(LogAutoSizeComments, Log, TEXT("Loaded auto size comments cache from old cache path: %s"), *GetAlternateCachePath(true));
+			SerializeBinaryCommentData(Reader, NewCommentData);
 		}
-		else
+
+		// the last record may have been cut short if the editor closed while writing
+		if (Reader.IsError())
 		{
-			UE_LOG(LogAutoSizeComments, Log, TEXT("Failed to load auto size comments cache from old cache path: %s"), *GetAlternateCachePath(true));
+			break;
+		}
+
+		switch (static_cast<EASCJournalOp>(Op))
+		{
+			case EASCJournalOp::ResetGraph:
+				PackageData.GraphData.FindOrAdd(GraphGuid).CommentData.Reset();
+				break;
+			case EASCJournalOp::SetComment:
+				PackageData.GraphData.FindOrAdd(GraphGuid).CommentData.Add(CommentGuid, MoveTemp(NewCommentData));
+				break;
+			case EASCJournalOp::RemoveComment:
+				if (FASCGraphData* GraphData = PackageData.GraphData.Find(GraphGuid))
+				{
+					GraphData->CommentData.Remove(CommentGuid);
+				}
+				break;
+			default: ;
 		}
+
+		++NumRecords;
 	}
 
-	return NewCacheData;
+	UE_LOG(LogAutoSizeComments, Verbose, TEXT("Replayed %d journal record(s) from %s"), NumRecords, *Path);
+	return true;
+}
+
+void FAutoSizeCommentsCacheFile::UpdateNodesUnderComment(UEdGraphNode_Comment* Comment)
+{
+	GetCommentData(Comment).UpdateNodesUnderComment(Comment);
+	MarkCommentDirty(Comment);
+}
+
+void FAutoSizeCommentsCacheFile::MarkCommentDirty(UEdGraphNode_Comment* Comment)
+{
+	if (!UAutoSizeCommentsSettings::Get().bWriteCacheJournal || !Comment)
+	{
+		return;
+	}
+
+	if (UEdGraph* Graph = Comment->GetGraph())
+	{
+		DirtyJournalComments.FindOrAdd(Graph->GetOutermost()->GetFName()).FindOrAdd(Graph->GraphGuid).Add(Comment->NodeGuid);
+	}
+}
+
+void FAutoSizeCommentsCacheFile::MarkGraphDirty(UEdGraph* Graph)
+{
+	if (!UAutoSizeCommentsSettings::Get().bWriteCacheJournal || !Graph)
+	{
+		return;
+	}
+
+	DirtyJournalComments.FindOrAdd(Graph->GetOutermost()->GetFName()).FindOrAdd(Graph->GraphGuid).Add(FGuid());
+}
+
+void FAutoSizeCommentsCacheFile::FlushJournal()
+{
+	if (DirtyJournalComments.Num() == 0 && PackagesRequiringCompaction.Num() == 0)
+	{
+		return;
+	}
+
+	const UAutoSizeCommentsSettings& Settings = UAutoSizeCommentsSettings::Get();
+	if (!bHasLoaded || Settings.CacheSaveMethod != EASCCacheSaveMethod::File || GIsCookerLoadingPackage)
+	{
+		DirtyJournalComments.Reset();
+		PackagesRequiringCompaction.Reset();
+		return;
+	}
+
+	// the journal is replayed on top of the package files, split the single cache file first
+	if (bRequiresPackageCacheMigration)
+	{
+		SaveCacheToFile();
+	}
+
+	// the package files are being written and will remove their journal when finished, wait until then
+	if (PendingSave.IsValid() && !PendingSave.IsReady())
+	{
+		return;
+	}
+
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FAutoSizeCommentsCacheFile::FlushJournal"), STAT_ASC_CacheFile_FlushJournal, STATGROUP_AutoSizeComments);
+
+	if (Settings.bWriteCacheJournal)
+	{
+		const int64 CompactionSize = static_cast<int64>(Settings.CacheJournalCompactionSize) * 1024;
+		for (const auto& Elem : DirtyJournalComments)
+		{
+			if (WriteJournal(Elem.Key, Elem.Value) > CompactionSize)
+			{
+				PackagesRequiringCompaction.Add(Elem.Key);
+			}
+		}
+	}
+
+	DirtyJournalComments.Reset();
+
+	if (PackagesRequiringCompaction.Num() > 0)
+	{
+		SavePackagesToFile(PackagesRequiringCompaction);
+		PackagesRequiringCompaction.Reset();
+	}
+}
+
+int64 FAutoSizeCommentsCacheFile::WriteJournal(FName PackageName, const TMap<FGuid, TSet<FGuid>>& DirtyGraphs)
+{
+	const FString JournalPath = GetJournalPath(GetPackageCachePath(PackageName));
+	const int64 JournalSize = IFileManager::Get().FileSize(*JournalPath);
+
+	TArray<uint8> Records;
+	FMemoryWriter Writer(Records);
+
+	if (JournalSize <= 0)
+	{
+		uint32 Magic = JournalMagic;
+		int32 Version = JournalVersion;
+		Writer << Magic;
+		Writer << Version;
+	}
+
+	const auto WriteRecord = [&Writer](EASCJournalOp Op, FGuid GraphGuid, FGuid CommentGuid, FASCCommentData* CommentData)
+	{
+		uint8 OpValue = static_cast<uint8>(Op);
+		Writer << OpValue;
+		Writer << GraphGuid;
+		Writer << CommentGuid;
+
+		if (CommentData)
+		{
+			SerializeBinaryCommentData(Writer, *CommentData);
+		}
+	};
+
+	FASCPackageData* PackageData = CacheData.PackageData.Find(PackageName);
+	for (const auto& Elem : DirtyGraphs)
+	{
+		const FGuid& GraphGuid = Elem.Key;
+		FASCGraphData* GraphData = PackageData ? PackageData->GraphData.Find(GraphGuid) : nullptr;
+
+		if (Elem.Value.Contains(FGuid()))
+		{
+			// rewrite the whole graph
+			WriteRecord(EASCJournalOp::ResetGraph, GraphGuid, FGuid(), nullptr);
+			if (GraphData)
+			{
+				for (auto& Comment : GraphData->CommentData)
+				{
+					WriteRecord(EASCJournalOp::SetComment, GraphGuid, Comment.Key, &Comment.Value);
+				}
+			}
+
+			continue;
+		}
+
+		for (const FGuid& CommentGuid : Elem.Value)
+		{
+			if (FASCCommentData* CommentData = GraphData ? GraphData->CommentData.Find(CommentGuid) : nullptr)
+			{
+				WriteRecord(EASCJournalOp::SetComment, GraphGuid, CommentGuid, CommentData);
+			}
+			else
+			{
+				WriteRecord(EASCJournalOp::RemoveComment, GraphGuid, CommentGuid, nullptr);
+			}
+		}
+	}
+
+	if (!FFileHelper::SaveArrayToFile(Records, *JournalPath, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogAutoSizeComments, Warning, TEXT("Failed to write comment cache journal: %s"), *JournalPath);
+		return JournalSize;
+	}
+
+	return FMath::Max<int64>(JournalSize, 0) + Records.Num();
 }
 
 void FAutoSizeCommentsCacheFile::InitMetaData()
@@ -145,6 +595,26 @@ void FAutoSizeCommentsCacheFile::InitMetaData()
 }
 
 void FAutoSizeCommentsCacheFile::SaveCacheToFile()
+{
+	// write every package which was opened this session
+	SavePackagesToFile(TouchedPackages);
+}
+
+void FAutoSizeCommentsCacheFile::QueuePackageSave(UEdGraph* Graph)
+{
+	if (Graph)
+	{
+		QueuedPackageSaves.Add(Graph->GetOutermost()->GetFName());
+	}
+}
+
+void FAutoSizeCommentsCacheFile::SaveQueuedPackages()
+{
+	SavePackagesToFile(QueuedPackageSaves);
+	QueuedPackageSaves.Reset();
+}
+
+void FAutoSizeCommentsCacheFile::SavePackagesToFile(const TSet<FName>& PackageNames)
 {
 	if (UAutoSizeCommentsSettings::Get().CacheSaveMethod != EASCCacheSaveMethod::File)
 	{
@@ -159,37 +629,136 @@ void FAutoSizeCommentsCacheFile::SaveCacheToFile()
 
 	for (UEdGraph* Graph : FAutoSizeCommentGraphHandler::Get().GetActiveGraphs())
 	{
-		FASCGraphData& CacheGraphData = GetGraphData(Graph);
-		CacheGraphData.CleanupGraph(Graph);
+		if (PackageNames.Contains(Graph->GetOutermost()->GetFName()))
+		{
+			FASCGraphData& CacheGraphData = GetGraphData(Graph);
+			CacheGraphData.CleanupGraph(Graph);
+		}
 	}
 
 	const double StartTime = FPlatformTime::Seconds();
 
-	const auto CachePath = GetCachePath();
+	TArray<FName> PackagesToSave = PackageNames.Array();
+	if (bRequiresPackageCacheMigration)
+	{
+		CacheData.PackageData.GetKeys(PackagesToSave);
+	}
 
-	// Write data to file
-	FString JsonAsString;
-	FJsonObjectConverter::UStructToJsonObjectString(CacheData, JsonAsString, 0, 0, 0, nullptr, UAutoSizeCommentsSettings::Get().bPrettyPrintCommentCacheJSON);
-	FFileHelper::SaveStringToFile(JsonAsString, *CachePath);
-	const double TimeTaken = (FPlatformTime::Seconds() - StartTime) * 1000.0f;
-	UE_LOG(LogAutoSizeComments, Log, TEXT("Saved cache to %s took %6.2fms"), *GetCachePath(true), TimeTaken);
+	// snapshot the package data, an empty snapshot deletes the package file
+	TArray<TPair<FString, FASCCacheData>> PackageFiles;
+	PackageFiles.Reserve(PackagesToSave.Num());
+	for (FName PackageName : PackagesToSave)
+	{
+		FASCCacheData& Snapshot = PackageFiles.Emplace_GetRef(GetPackageCachePath(PackageName), FASCCacheData()).Value;
+
+		const FASCPackageData* PackageData = CacheData.PackageData.Find(PackageName);
+		if (PackageData && PackageData->GraphData.Num() > 0)
+		{
+			Snapshot.PackageData.Add(PackageName, *PackageData);
+		}
+
+		// the snapshot replaces the package's journal
+		DirtyJournalComments.Remove(PackageName);
+	}
+
+	// the single cache file has been split into the package files
+	const FString OldCachePath = bRequiresPackageCacheMigration ? GetCachePath() : FString();
+	bRequiresPackageCacheMigration = false;
+
+	const bool bPrettyPrintJson = UAutoSizeCommentsSettings::Get().bPrettyPrintCommentCacheJSON;
+	const FString PackageCacheDir = FPaths::ConvertRelativePathToFull(GetPackageCacheDirectory());
+
+	// files are written in order, wait for the previous save to finish
+	WaitForPendingSave();
+
+	// serialize and write the files on a worker thread
+	PendingSave = Async(EAsyncExecution::ThreadPool, [PackageFiles = MoveTemp(PackageFiles), OldCachePath, bPrettyPrintJson, PackageCacheDir, StartTime]() mutable
+	{
+		for (TPair<FString, FASCCacheData>& PackageFile : PackageFiles)
+		{
+			WritePackageCacheFile(PackageFile.Key, PackageFile.Value, bPrettyPrintJson);
+		}
+
+		if (!OldCachePath.IsEmpty())
+		{
+			DeleteCacheFile(OldCachePath);
+		}
+
+		const double TimeTaken = (FPlatformTime::Seconds() - StartTime) * 1000.0f;
+		UE_LOG(LogAutoSizeComments, Log, TEXT("Saved %d package(s) to %s took %6.2fms"), PackageFiles.Num(), *PackageCacheDir, TimeTaken);
+	});
+}
+
+void FAutoSizeCommentsCacheFile::WaitForPendingSave()
+{
+	if (PendingSave.IsValid())
+	{
+		PendingSave.Wait();
+		PendingSave.Reset();
+	}
+}
+
+void FAutoSizeCommentsCacheFile::SaveCacheOnExit()
+{
+	SaveCacheToFile();
+	WaitForPendingSave();
+}
+
+void FAutoSizeCommentsCacheFile::WritePackageCacheFile(const FString& Path, FASCCacheData& PackageCacheData, bool bPrettyPrintJson)
+{
+	if (PackageCacheData.PackageData.Num() == 0)
+	{
+		DeleteCacheFile(Path);
+		return;
+	}
+
+	if (!SaveCacheDataToPath(Path, PackageCacheData, bPrettyPrintJson))
+	{
+		UE_LOG(LogAutoSizeComments, Warning, TEXT("Failed to write package cache file: %s"), *Path);
+		return;
+	}
+
+	// remove the file in the other format so it isn't read instead
+	const FString OtherExtension = FPaths::GetExtension(Path) == BinaryCacheExtension ? TEXT("json") : BinaryCacheExtension;
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*FPaths::ChangeExtension(Path, OtherExtension));
+
+	// the journaled changes are now part of the cache file
+	FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*GetJournalPath(Path));
+}
+
+void FAutoSizeCommentsCacheFile::DeleteCacheFile(const FString& Path)
+{
+	for (const TCHAR* Extension : { TEXT("json"), BinaryCacheExtension, JournalExtension })
+	{
+		const FString CacheFile = FPaths::ChangeExtension(Path, Extension);
+		if (FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*CacheFile))
+		{
+			UE_LOG(LogAutoSizeComments, Log, TEXT("Deleted cache file at %s"), *CacheFile);
+		}
+	}
 }
 
 void FAutoSizeCommentsCacheFile::DeleteCache()
 {
+	WaitForPendingSave();
+
 	const FString ProjectCachePath = GetProjectCachePath();
 	const FString PluginCachePath = GetPluginCachePath();
 
 	CacheData.PackageData.Reset();
+	UnloadedPackageFiles.Reset();
+	DirtyJournalComments.Reset();
+	PackagesRequiringCompaction.Reset();
+	bRequiresPackageCacheMigration = false;
 
-	if (FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*ProjectCachePath))
-	{
-		UE_LOG(LogAutoSizeComments, Log, TEXT("Deleted project cache file at %s"), *GetCachePath(true));
-	}
+	// delete the cache in both formats
+	DeleteCacheFile(ProjectCachePath);
+	DeleteCacheFile(PluginCachePath);
 
-	if (FPlatformFileManager::Get().GetPlatformFile().DeleteFile(*PluginCachePath))
+	const FString PackageCacheDir = GetPackageCacheDirectory();
+	if (FPlatformFileManager::Get().GetPlatformFile().DeleteDirectoryRecursively(*PackageCacheDir))
 	{
-		UE_LOG(LogAutoSizeComments, Log, TEXT("Deleted plugin cache file at %s"), *GetCachePath(true));
+		UE_LOG(LogAutoSizeComments, Log, TEXT("Deleted package cache files at %s"), *PackageCacheDir);
 	}
 }
 
@@ -232,6 +801,17 @@ void FAutoSizeCommentsCacheFile::CleanupFiles()
 		if (!CurrentPackageNames.Contains(PackageGuid))
 		{
 			CacheData.PackageData.Remove(PackageGuid);
+			DeleteCacheFile(GetPackageCachePath(PackageGuid));
+		}
+	}
+
+	// delete the files for packages which no longer exist
+	for (auto Iter = UnloadedPackageFiles.CreateIterator(); Iter; ++Iter)
+	{
+		if (!CurrentPackageNames.Contains(Iter.Key()))
+		{
+			DeleteCacheFile(Iter.Value());
+			Iter.RemoveCurrent();
 		}
 	}
 }
@@ -259,7 +839,11 @@ FASCGraphData& FAutoSizeCommentsCacheFile::GetGraphData(UEdGraph* Graph)
 		// if we have no data, try loading from the package's meta data
 		if (GraphData.IsEmpty())
 		{
-			GraphData.LoadFromPackageMetaData(Graph);
+			if (GraphData.LoadFromPackageMetaData(Graph))
+			{
+				MarkGraphDirty(Graph);
+			}
+
 			GraphData.bInitialized = true;
 		}
 
@@ -295,7 +879,8 @@ FASCGraphData& FAutoSizeCommentsCacheFile::GetGraphData(UEdGraph* Graph)
 bool FAutoSizeCommentsCacheFile::RemoveGraphData(UEdGraph* Graph)
 {
 	UPackage* Package = Graph->GetOutermost();
-	FASCPackageData& PackageData = CacheData.PackageData.FindOrAdd(Package->GetFName());
+	FASCPackageData& PackageData = FindOrLoadPackageData(Package->GetFName());
+	MarkGraphDirty(Graph);
 	return PackageData.GraphData.Remove(Graph->GraphGuid) > 0;
 }
 
@@ -317,7 +902,7 @@ void FAutoSizeCommentsCacheFile::ClearPackageMetaData(UEdGraph* Graph)
 
 FString FAutoSizeCommentsCacheFile::GetProjectCachePath(bool bFullPath)
 {
-	return FPaths::ProjectDir() / TEXT("Saved") / TEXT("AutoSizeComments") / TEXT("AutoSizeCommentsCache.json");
+	return FPaths::ProjectDir() / TEXT("Saved") / TEXT("AutoSizeComments") / TEXT("AutoSizeCommentsCache.") + GetCacheFileExtension();
 }
 
 FString FAutoSizeCommentsCacheFile::GetPluginCachePath(bool bFullPath)
@@ -332,7 +917,39 @@ FString FAutoSizeCommentsCacheFile::GetPluginCachePath(bool bFullPath)
 	const UGeneralProjectSettings* ProjectSettings = GetDefault<UGeneralProjectSettings>();
 	const FGuid& ProjectID = ProjectSettings->ProjectID;
 
-	return PluginDir + "/ASCCache/" + ProjectID.ToString() + ".json";
+	return PluginDir + "/ASCCache/" + ProjectID.ToString() + "." + GetCacheFileExtension();
+}
+
+FString FAutoSizeCommentsCacheFile::GetPackageCacheDirectory()
+{
+	if (UAutoSizeCommentsSettings::Get().CacheSaveLocation == EASCCacheSaveLocation::Project)
+	{
+		return FPaths::ProjectDir() / TEXT("Saved") / TEXT("AutoSizeComments") / TEXT("Packages");
+	}
+
+	return FPaths::GetPath(GetPluginCachePath()) / GetDefault<UGeneralProjectSettings>()->ProjectID.ToString();
+}
+
+FString FAutoSizeCommentsCacheFile::GetPackageCachePath(FName PackageName)
+{
+	// "." is not valid in a package name, use it in place of the path separators
+	FString FileName = PackageName.ToString();
+	FileName.RemoveFromStart(TEXT("/"));
+	FileName.ReplaceInline(TEXT("/"), TEXT("."));
+
+	return GetPackageCacheDirectory() / FileName + TEXT(".") + GetCacheFileExtension();
+}
+
+FName FAutoSizeCommentsCacheFile::GetPackageNameFromCachePath(const FString& Path)
+{
+	FString PackageName = FPaths::GetBaseFilename(Path);
+	PackageName.ReplaceInline(TEXT("."), TEXT("/"));
+	return FName(TEXT("/") + PackageName);
+}
+
+FString FAutoSizeCommentsCacheFile::GetCacheFileExtension()
+{
+	return UAutoSizeCommentsSettings::Get().CacheFileFormat == EASCCacheFileFormat::Binary ? BinaryCacheExtension : TEXT("json");
 }
 
 FString FAutoSizeCommentsCacheFile::GetCachePath(bool bFullPath)
@@ -349,20 +966,21 @@ FString FAutoSizeCommentsCacheFile::GetAlternateCachePath(bool bFullPath)
 
 bool FAutoSizeCommentsCacheFile::GetNodesUnderComment(TSharedPtr<SAutoSizeCommentsGraphNode> ASCNode, TArray<UEdGraphNode*>& OutNodesUnderComment)
 {
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FAutoSizeCommentsCacheFile::GetNodesUnderComment"), STAT_ASC_CacheFile_GetNodesUnderComment, STATGROUP_AutoSizeComments);
+
 	UEdGraphNode* Node = ASCNode->GetNodeObj();
 	UEdGraph* Graph = Node->GetGraph();
 	FASCGraphData& Data = GetGraphData(Graph);
-	if (Data.CommentData.Contains(Node->NodeGuid))
+	if (const FASCCommentData* CommentData = Data.CommentData.Find(Node->NodeGuid))
 	{
-		for (FGuid NodeInsideGuid : Data.CommentData[Node->NodeGuid].NodeGuids)
+		FAutoSizeCommentGraphHandler& GraphHandler = FAutoSizeCommentGraphHandler::Get();
+		OutNodesUnderComment.Reserve(OutNodesUnderComment.Num() + CommentData->NodeGuids.Num());
+
+		for (const FGuid& NodeInsideGuid : CommentData->NodeGuids)
 		{
-			for (UEdGraphNode* NodeOnGraph : Graph->Nodes)
+			if (UEdGraphNode* NodeOnGraph = GraphHandler.FindNodeByGuid(Graph, NodeInsideGuid))
 			{
-				if (NodeOnGraph->NodeGuid == NodeInsideGuid)
-				{
-					OutNodesUnderComment.Add(NodeOnGraph);
-					break;
-				}
+				OutNodesUnderComment.Add(NodeOnGraph);
 			}
 		}
 
@@ -414,7 +1032,9 @@ void FAutoSizeCommentsCacheFile::OnObjectLoaded(UObject* Obj)
 FASCGraphData& FAutoSizeCommentsCacheFile::GetCacheFileGraphData(UEdGraph* Graph)
 {
 	UPackage* Package = Graph->GetOutermost();
-	FASCPackageData& PackageData = CacheData.PackageData.FindOrAdd(Package->GetFName());
+	TouchedPackages.Add(Package->GetFName());
+
+	FASCPackageData& PackageData = FindOrLoadPackageData(Package->GetFName());
 	FASCGraphData& GraphData = PackageData.GraphData.FindOrAdd(Graph->GraphGuid);
 	return GraphData;
 }
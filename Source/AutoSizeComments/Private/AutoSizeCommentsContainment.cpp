@@ -0,0 +1,162 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "AutoSizeCommentsContainment.h"
+
+#include "AutoSizeCommentsGraphNode.h"
+#include "EdGraphNode_Comment.h"
+#include "EdGraph/EdGraph.h"
+
+void FASCCommentContainment::Rebuild(UEdGraph* Graph)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCCommentContainment::Rebuild"), STAT_ASC_CommentContainment_Rebuild, STATGROUP_AutoSizeComments);
+
+	NodeToComments.Reset();
+	NestingDepths.Reset();
+	bRequiresRebuild = false;
+
+	if (!Graph)
+	{
+		return;
+	}
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
+		{
+			for (UObject* Obj : Comment->GetNodesUnderComment())
+			{
+				OnNodeAdded(Comment, Obj);
+			}
+		}
+	}
+}
+
+void FASCCommentContainment::OnNodeAdded(UEdGraphNode_Comment* Comment, UObject* Node)
+{
+	if (bRequiresRebuild || !Node)
+	{
+		return;
+	}
+
+	NodeToComments.FindOrAdd(Node).AddUnique(Comment);
+
+	// a comment nested in another changes the depths
+	if (Node->IsA<UEdGraphNode_Comment>())
+	{
+		NestingDepths.Reset();
+	}
+}
+
+void FASCCommentContainment::OnCommentCleared(UEdGraphNode_Comment* Comment)
+{
+	if (bRequiresRebuild)
+	{
+		return;
+	}
+
+	for (UObject* Node : Comment->GetNodesUnderComment())
+	{
+		if (TArray<TWeakObjectPtr<UEdGraphNode_Comment>>* Comments = NodeToComments.Find(Node))
+		{
+			Comments->RemoveSingleSwap(Comment);
+		}
+	}
+
+	NestingDepths.Reset();
+}
+
+TArray<UEdGraphNode_Comment*> FASCCommentContainment::GetContainingComments(UObject* Node) const
+{
+	return ToCommentArray(NodeToComments.Find(Node));
+}
+
+bool FASCCommentContainment::IsContained(UObject* Node) const
+{
+	if (const TArray<TWeakObjectPtr<UEdGraphNode_Comment>>* Parents = NodeToComments.Find(Node))
+	{
+		return Parents->ContainsByPredicate([](const TWeakObjectPtr<UEdGraphNode_Comment>& Parent) { return Parent.IsValid(); });
+	}
+
+	return false;
+}
+
+bool FASCCommentContainment::IsAncestorOf(UEdGraphNode_Comment* Ancestor, UEdGraphNode_Comment* Comment) const
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCCommentContainment::IsAncestorOf"), STAT_ASC_CommentContainment_IsAncestorOf, STATGROUP_AutoSizeComments);
+
+	if (!Ancestor || !Comment)
+	{
+		return false;
+	}
+
+	TArray<UEdGraphNode_Comment*, TInlineAllocator<16>> Pending;
+	TArray<UEdGraphNode_Comment*, TInlineAllocator<16>> Visited;
+	Pending.Add(Comment);
+
+	while (Pending.Num() > 0)
+	{
+		UEdGraphNode_Comment* Current = Pending.Pop();
+		if (Visited.Contains(Current))
+		{
+			continue;
+		}
+
+		Visited.Add(Current);
+
+		if (const TArray<TWeakObjectPtr<UEdGraphNode_Comment>>* Parents = NodeToComments.Find(Current))
+		{
+			for (const TWeakObjectPtr<UEdGraphNode_Comment>& Parent : *Parents)
+			{
+				if (Parent.Get() == Ancestor)
+				{
+					return true;
+				}
+
+				if (Parent.IsValid())
+				{
+					Pending.Add(Parent.Get());
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+int32 FASCCommentContainment::GetNestingDepth(UEdGraphNode_Comment* Comment) const
+{
+	if (const int32* Depth = NestingDepths.Find(Comment))
+	{
+		return *Depth;
+	}
+
+	// guard against comments which contain each other
+	NestingDepths.Add(Comment, 0);
+
+	int32 Depth = 0;
+	for (UEdGraphNode_Comment* Parent : GetContainingComments(Comment))
+	{
+		Depth = FMath::Max(Depth, GetNestingDepth(Parent) + 1);
+	}
+
+	NestingDepths.Add(Comment, Depth);
+	return Depth;
+}
+
+TArray<UEdGraphNode_Comment*> FASCCommentContainment::ToCommentArray(const TArray<TWeakObjectPtr<UEdGraphNode_Comment>>* WeakComments)
+{
+	TArray<UEdGraphNode_Comment*> Comments;
+	if (WeakComments)
+	{
+		Comments.Reserve(WeakComments->Num());
+		for (const TWeakObjectPtr<UEdGraphNode_Comment>& WeakComment : *WeakComments)
+		{
+			if (UEdGraphNode_Comment* Comment = WeakComment.Get())
+			{
+				Comments.Add(Comment);
+			}
+		}
+	}
+
+	return Comments;
+}
@@ -28,6 +28,8 @@
 #include "Misc/TransactionObjectEvent.h"
 #endif
 
+DECLARE_DWORD_COUNTER_STAT(TEXT("Coalesced Graph Events"), STAT_ASC_CoalescedGraphEvents, STATGROUP_AutoSizeComments);
+
 
 struct FASCZoomLevel
 {
@@ -139,6 +141,7 @@ void FAutoSizeCommentGraphHandler::BindDelegates()
 #endif
 
 	FCoreUObjectDelegates::OnObjectTransacted.AddRaw(this, &FAutoSizeCommentGraphHandler::OnObjectTransacted);
+	FCoreUObjectDelegates::OnObjectModified.AddRaw(this, &FAutoSizeCommentGraphHandler::OnObjectModified);
 	FCoreUObjectDelegates::GetPostGarbageCollect().AddRaw(this, &FAutoSizeCommentGraphHandler::OnPostGarbageCollect);
 }
 
@@ -150,6 +153,7 @@ void FAutoSizeCommentGraphHandler::UnbindDelegates()
 	FCoreUObjectDelegates::OnObjectSaved.RemoveAll(this);
 #endif
 	FCoreUObjectDelegates::OnObjectTransacted.RemoveAll(this);
+	FCoreUObjectDelegates::OnObjectModified.RemoveAll(this);
 
 	FCoreUObjectDelegates::GetPostGarbageCollect().RemoveAll(this);
 
@@ -185,6 +189,39 @@ void FAutoSizeCommentGraphHandler::BindToGraph(UEdGraph* Graph)
 
 void FAutoSizeCommentGraphHandler::OnGraphChanged(const FEdGraphEditAction& Action)
 {
+	if (Action.Graph)
+	{
+		if (FASCGraphHandlerData* GraphData = GraphDatas.Find(Action.Graph))
+		{
+			GraphData->bCheckForInvalidNodes = true;
+			GraphData->bGuidToNodeDirty = true;
+			GraphData->CommentBroadphase.Invalidate();
+
+			// new nodes are not under any comment and deleted nodes are removed from their comments in OnNodeDeleted
+			if ((Action.Action & (GRAPHACTION_AddNode | GRAPHACTION_RemoveNode)) == 0)
+			{
+				GraphData->CommentContainment.Invalidate();
+			}
+
+			// new nodes are not related to the highlighted comments, a generic change (e.g. undo) may have added nodes too
+			if ((Action.Action & GRAPHACTION_AddNode) != 0)
+			{
+				GraphData->NodeHighlight.OnNodesAdded(Action.Nodes);
+			}
+			else if (Action.Action == GRAPHACTION_Default)
+			{
+				GraphData->NodeHighlight.Invalidate();
+			}
+		}
+
+		InvalidateSpatialIndices(const_cast<UEdGraph*>(Action.Graph));
+	}
+
+	for (const UEdGraphNode* Node : Action.Nodes)
+	{
+		MarkNodeModified(const_cast<UEdGraphNode*>(Node));
+	}
+
 	if ((Action.Action & GRAPHACTION_AddNode) != 0 && Action.bUserInvoked)
 	{
 		// only handle single node added 
@@ -192,9 +229,11 @@ void FAutoSizeCommentGraphHandler::OnGraphChanged(const FEdGraphEditAction& Acti
 		{
 			UEdGraphNode* NewNode = const_cast<UEdGraphNode*>(Action.Nodes.Array()[0]);
 
-			// delay 1 tick as some nodes do not have their pins setup correctly on creation
-			GEditor->GetTimerManager()->SetTimerForNextTick(
-				FTimerDelegate::CreateRaw(this, &FAutoSizeCommentGraphHandler::OnNodeAdded, TWeakObjectPtr<UEdGraphNode>(NewNode)));
+			// delay 1 frame as some nodes do not have their pins setup correctly on creation
+			if (FASCGraphHandlerData* GraphData = GraphDatas.Find(NewNode->GetGraph()))
+			{
+				FASCDeferredGraphWork::QueueNode(GraphData->DeferredWork.AddedNodes, NewNode);
+			}
 		}
 	}
 	else if ((Action.Action & GRAPHACTION_RemoveNode) != 0)
@@ -237,9 +276,7 @@ void FAutoSizeCommentGraphHandler::AutoInsertIntoCommentNodes(TWeakObjectPtr<UEd
 			if (!Graph || !Node || !NodeToTakeFrom)
 				return;
 
-			TArray<UEdGraphNode_Comment*> CommentNodes;
-			Graph->GetNodesOfClass(CommentNodes);
-			auto ContainingComments = FASCUtils::GetContainingCommentNodes(CommentNodes, NodeToTakeFrom);
+			auto ContainingComments = FASCUtils::GetContainingCommentNodes(NodeToTakeFrom);
 			for (UEdGraphNode_Comment* CommentNode : ContainingComments)
 			{
 				FASCUtils::AddNodeIntoComment(CommentNode, Node);
@@ -274,10 +311,8 @@ void FAutoSizeCommentGraphHandler::AutoInsertIntoCommentNodes(TWeakObjectPtr<UEd
 			return;
 		}
 
-		TArray<UEdGraphNode_Comment*> CommentNodes;
-		Graph->GetNodesOfClass(CommentNodes);
-		auto ContainingCommentsA = FASCUtils::GetContainingCommentNodes(CommentNodes, NodeA);
-		auto ContainingCommentsB = FASCUtils::GetContainingCommentNodes(CommentNodes, NodeB);
+		auto ContainingCommentsA = FASCUtils::GetContainingCommentNodes(NodeA);
+		auto ContainingCommentsB = FASCUtils::GetContainingCommentNodes(NodeB);
 
 		ContainingCommentsA.RemoveAll([&ContainingCommentsB](UEdGraphNode_Comment* Comment)
 		{
@@ -406,6 +441,7 @@ void FAutoSizeCommentGraphHandler::CheckCacheDataError(UEdGraph* Graph)
 		FSlateNotificationManager::Get().AddNotification(Info);
 
 		GraphData.CommentData.Empty();
+		FAutoSizeCommentsCacheFile::Get().MarkGraphDirty(Graph);
 	}
 }
 
@@ -569,7 +605,7 @@ void FAutoSizeCommentGraphHandler::ProcessAltReleased(TSharedPtr<SGraphPanel> Gr
 
 			if (bChanged)
 			{
-				CommentNode->ClearNodesUnderComment();
+				FASCUtils::ClearCommentNodes(CommentNode, false);
 				ASCGraphNode->AddAllNodesUnderComment(NewSelection.Array(), false);
 				ChangedGraphNodes.Add(ASCGraphNode);
 
@@ -628,7 +664,7 @@ void FAutoSizeCommentGraphHandler::UpdateCommentChangeState(UEdGraphNode_Comment
 	}
 
 	FASCGraphHandlerData& GraphData = GetGraphHandlerData(Graph);
-	GraphData.CommentChangeData.FindOrAdd(Comment->NodeGuid).UpdateComment(Comment);
+	GraphData.CommentChangeData.FindOrAdd(Comment->NodeGuid).UpdateComment(Comment, GraphData.NodeChangeStore);
 }
 
 bool FAutoSizeCommentGraphHandler::HasCommentChangeState(UEdGraphNode_Comment* Comment) const
@@ -650,13 +686,153 @@ bool FAutoSizeCommentGraphHandler::HasCommentChanged(UEdGraphNode_Comment* Comme
 	{
 		if (FASCCommentChangeData* CommentChangeData = GraphData->CommentChangeData.Find(Comment->NodeGuid))
 		{
-			return CommentChangeData->HasCommentChanged(Comment);
+			return CommentChangeData->HasCommentChanged(Comment, GraphData->NodeChangeStore);
 		}
 	}
 
 	return false;
 }
 
+FASCCommentContainment& FAutoSizeCommentGraphHandler::GetCommentContainment(UEdGraph* Graph)
+{
+	FASCGraphHandlerData& GraphData = GetGraphHandlerData(Graph);
+	FASCCommentContainment& Containment = GraphData.CommentContainment;
+	if (Containment.RequiresRebuild())
+	{
+		Containment.Rebuild(Graph);
+
+		// the nodes inside the comments may have changed
+		GraphData.BoundsCache.InvalidateComments();
+	}
+
+	return Containment;
+}
+
+FASCCommentContainment* FAutoSizeCommentGraphHandler::FindCommentContainment(UEdGraph* Graph)
+{
+	FASCGraphHandlerData* GraphData = GraphDatas.Find(Graph);
+	return GraphData ? &GraphData->CommentContainment : nullptr;
+}
+
+UEdGraphNode* FAutoSizeCommentGraphHandler::FindNodeByGuid(UEdGraph* Graph, const FGuid& NodeGuid)
+{
+	FASCGraphHandlerData& GraphData = GetGraphHandlerData(Graph);
+
+	const auto FindNode = [&GraphData, Graph, &NodeGuid]() -> UEdGraphNode*
+	{
+		UEdGraphNode* Node = GraphData.GuidToNode.FindRef(NodeGuid).Get();
+		return (Node && Node->NodeGuid == NodeGuid && Node->GetGraph() == Graph) ? Node : nullptr;
+	};
+
+	if (!GraphData.bGuidToNodeDirty)
+	{
+		if (UEdGraphNode* Node = FindNode())
+		{
+			return Node;
+		}
+
+		// not every method of adding nodes notifies the graph, so check if the graph has changed before failing
+		if (GraphData.GuidToNodeNumGraphNodes == Graph->Nodes.Num())
+		{
+			return nullptr;
+		}
+	}
+
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FAutoSizeCommentGraphHandler::FindNodeByGuid::Rebuild"), STAT_ASC_FindNodeByGuid_Rebuild, STATGROUP_AutoSizeComments);
+
+	GraphData.GuidToNode.Reset();
+	GraphData.GuidToNode.Reserve(Graph->Nodes.Num());
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node)
+		{
+			GraphData.GuidToNode.Add(Node->NodeGuid, Node);
+		}
+	}
+
+	GraphData.GuidToNodeNumGraphNodes = Graph->Nodes.Num();
+	GraphData.bGuidToNodeDirty = false;
+
+	return FindNode();
+}
+
+void FAutoSizeCommentGraphHandler::MarkNodeModified(UEdGraphNode* Node)
+{
+	if (!Node)
+	{
+		return;
+	}
+
+	for (FASCSpatialIndex* SpatialIndex : FindSpatialIndices(Node->GetGraph()))
+	{
+		SpatialIndex->MarkNodeDirty(Node);
+	}
+
+	// only track graphs we are bound to
+	if (FASCGraphHandlerData* GraphData = GraphDatas.Find(Node->GetGraph()))
+	{
+		GraphData->ModifiedNodes.Add(Node);
+		GraphData->NodeChangeStore.MarkNodeDirty(Node);
+		GraphData->BoundsCache.MarkNodeDirty(Node);
+
+		// the nodes inside the comment may have changed
+		if (UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
+		{
+			GraphData->BoundsCache.InvalidateComment(Comment);
+		}
+	}
+}
+
+FASCCommentBroadphase& FAutoSizeCommentGraphHandler::GetCommentBroadphase(UEdGraph* Graph)
+{
+	FASCCommentBroadphase& Broadphase = GetGraphHandlerData(Graph).CommentBroadphase;
+	Broadphase.Update(Graph);
+	return Broadphase;
+}
+
+FSlateRect FAutoSizeCommentGraphHandler::GetNodeBounds(TSharedPtr<SGraphPanel> GraphPanel, UEdGraphNode* Node)
+{
+	if (!Node)
+	{
+		return FSlateRect();
+	}
+
+	// the cached bounds are only kept up to date by the geometry scan in reactive mode
+	if (GetResizingMode(Node->GetGraph()) != EASCResizingMode::Reactive)
+	{
+		if (TSharedPtr<SGraphNode> NodeWidget = FASCUtils::GetGraphNode(GraphPanel, Node))
+		{
+			return FASCBoundsCache::CalculateNodeBounds(*NodeWidget);
+		}
+	}
+
+	return GetGraphHandlerData(Node->GetGraph()).BoundsCache.GetNodeBounds(GraphPanel, Node);
+}
+
+void FAutoSizeCommentGraphHandler::UpdateNodeBounds(SGraphNode& NodeWidget)
+{
+	UEdGraphNode* Node = NodeWidget.GetNodeObj();
+	if (!Node)
+	{
+		return;
+	}
+
+	if (FASCGraphHandlerData* GraphData = GraphDatas.Find(Node->GetGraph()))
+	{
+		const FASCCommentContainment& Containment = GetCommentContainment(Node->GetGraph());
+		GraphData->BoundsCache.UpdateNodeBounds(NodeWidget, Containment);
+
+		// parents are updated after their children, so they can resize later in this pass
+		for (UEdGraphNode_Comment* Parent : Containment.GetContainingComments(Node))
+		{
+			if (TSharedPtr<SAutoSizeCommentsGraphNode> ASCParent = FASCState::Get().GetASCComment(Parent))
+			{
+				ASCParent->bGeometryChanged = true;
+			}
+		}
+	}
+}
+
 TArray<UEdGraph*> FAutoSizeCommentGraphHandler::GetActiveGraphs()
 {
 	TArray<TWeakObjectPtr<UEdGraph>> GraphWeakPtrs;
@@ -675,6 +851,34 @@ TArray<UEdGraph*> FAutoSizeCommentGraphHandler::GetActiveGraphs()
 	return ActiveGraphs;
 }
 
+FASCSpatialIndex& FAutoSizeCommentGraphHandler::GetSpatialIndex(TSharedPtr<SGraphPanel> GraphPanel)
+{
+	if (FASCSpatialIndex* SpatialIndex = SpatialIndices.Find(GraphPanel))
+	{
+		return *SpatialIndex;
+	}
+
+	SpatialIndexPanels.FindOrAdd(GraphPanel->GetGraphObj()).Add(GraphPanel);
+	return SpatialIndices.Add(GraphPanel);
+}
+
+TArray<FASCSpatialIndex*, TInlineAllocator<2>> FAutoSizeCommentGraphHandler::FindSpatialIndices(UEdGraph* Graph)
+{
+	TArray<FASCSpatialIndex*, TInlineAllocator<2>> OutSpatialIndices;
+	if (const TArray<TWeakPtr<SGraphPanel>>* Panels = SpatialIndexPanels.Find(Graph))
+	{
+		for (const TWeakPtr<SGraphPanel>& Panel : *Panels)
+		{
+			if (FASCSpatialIndex* SpatialIndex = SpatialIndices.Find(Panel))
+			{
+				OutSpatialIndices.Add(SpatialIndex);
+			}
+		}
+	}
+
+	return OutSpatialIndices;
+}
+
 TArray<TSharedPtr<SGraphPanel>> FAutoSizeCommentGraphHandler::GetActiveGraphPanels()
 {
 	TArray<TSharedPtr<SGraphPanel>> OutGraphPanels;
@@ -691,13 +895,219 @@ TArray<TSharedPtr<SGraphPanel>> FAutoSizeCommentGraphHandler::GetActiveGraphPane
 
 bool FAutoSizeCommentGraphHandler::Tick(float DeltaTime)
 {
+	ProcessDeferredWork();
+
+	UpdateComments();
+
 	UpdateNodeUnrelatedState();
 
 	UpdateGraphPurgeTimer();
 
+	FAutoSizeCommentsCacheFile::Get().FlushJournal();
+
 	return true;
 }
 
+void FAutoSizeCommentGraphHandler::UpdateComments()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FAutoSizeCommentGraphHandler::UpdateComments"), STAT_ASC_UpdateComments, STATGROUP_AutoSizeComments);
+
+	// gather the comments which are currently being displayed, grouped by their graph
+	TMap<UEdGraph*, TArray<TSharedPtr<SAutoSizeCommentsGraphNode>>> CommentsByGraph;
+	for (const auto& Elem : FASCState::Get().CommentToASCMapping)
+	{
+		TSharedPtr<SAutoSizeCommentsGraphNode> ASCComment = Elem.Value.Pin();
+		if (!ASCComment || !ASCComment->ShouldUpdateComment())
+		{
+			continue;
+		}
+
+		UEdGraphNode_Comment* Comment = ASCComment->GetCommentNodeObj();
+		if (UEdGraph* Graph = Comment ? Comment->GetGraph() : nullptr)
+		{
+			CommentsByGraph.FindOrAdd(Graph).Add(ASCComment);
+		}
+	}
+
+	for (const auto& Elem : CommentsByGraph)
+	{
+		UpdateGraphComments(Elem.Key, Elem.Value);
+	}
+}
+
+void FAutoSizeCommentGraphHandler::UpdateGraphComments(UEdGraph* Graph, const TArray<TSharedPtr<SAutoSizeCommentsGraphNode>>& Comments)
+{
+	TSharedPtr<SGraphPanel> GraphPanel = Comments[0]->GetOwnerPanel();
+	if (!GraphPanel || FASCUtils::IsGraphReadOnly(GraphPanel))
+	{
+		return;
+	}
+
+	FASCGraphHandlerData& GraphData = GetGraphHandlerData(Graph);
+
+	// only check for deleted nodes when the graph has changed, the same node set is shared by all comments
+	TSet<UEdGraphNode*> GraphNodes;
+	const bool bCheckForInvalidNodes = GraphData.bCheckForInvalidNodes || GraphData.LastNumGraphNodes != Graph->Nodes.Num();
+	if (bCheckForInvalidNodes)
+	{
+		GraphNodes.Append(Graph->Nodes);
+		GraphData.bCheckForInvalidNodes = false;
+		GraphData.LastNumGraphNodes = Graph->Nodes.Num();
+	}
+
+	// flag the comments which contain any modified nodes
+	if (GraphData.ModifiedNodes.Num() > 0)
+	{
+		const FASCCommentContainment& Containment = GetCommentContainment(Graph);
+
+		const auto FlagComment = [](UEdGraphNode_Comment* Comment)
+		{
+			if (TSharedPtr<SAutoSizeCommentsGraphNode> ASCComment = FASCState::Get().GetASCComment(Comment))
+			{
+				ASCComment->bNodesModified = true;
+			}
+		};
+
+		for (const TWeakObjectPtr<UEdGraphNode>& ModifiedNode : GraphData.ModifiedNodes)
+		{
+			if (UEdGraphNode* Node = ModifiedNode.Get())
+			{
+				if (UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
+				{
+					FlagComment(Comment);
+				}
+
+				for (UEdGraphNode_Comment* Comment : Containment.GetContainingComments(Node))
+				{
+					FlagComment(Comment);
+				}
+			}
+		}
+
+		GraphData.ModifiedNodes.Reset();
+	}
+
+	// in reactive mode, resize the comments whose nodes have moved or resized since the last frame
+	// other modes don't use the cached bounds, so the panel's widgets are not scanned
+	if (GetResizingMode(Graph) == EASCResizingMode::Reactive)
+	{
+		TArray<UEdGraphNode*> ChangedNodes;
+		FindNodeGeometryChanges(GraphPanel, GraphData, ChangedNodes);
+
+		if (ChangedNodes.Num() > 0)
+		{
+			const FASCCommentContainment& Containment = GetCommentContainment(Graph);
+
+			const auto FlagComment = [](UEdGraphNode_Comment* Comment)
+			{
+				if (TSharedPtr<SAutoSizeCommentsGraphNode> ASCComment = FASCState::Get().GetASCComment(Comment))
+				{
+					ASCComment->bGeometryChanged = true;
+				}
+			};
+
+			for (UEdGraphNode* Node : ChangedNodes)
+			{
+				// the comment itself was moved or resized, ignoring the change made by its own resize
+				if (UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Node))
+				{
+					TSharedPtr<SAutoSizeCommentsGraphNode> ASCComment = FASCState::Get().GetASCComment(Comment);
+					if (ASCComment && !ASCComment->IsGeometryFromResize())
+					{
+						ASCComment->bGeometryChanged = true;
+					}
+				}
+
+				for (UEdGraphNode_Comment* Comment : Containment.GetContainingComments(Node))
+				{
+					FlagComment(Comment);
+				}
+			}
+		}
+	}
+
+	const bool bIsAltDown = FSlateApplication::Get().GetModifierKeys().IsAltDown();
+
+	// refresh when the alt key is released
+	if (!bIsAltDown && GraphData.bPreviousAltDown && UAutoSizeCommentsSettings::Get().AltCollisionMethod != ECommentCollisionMethod::Disabled)
+	{
+		ProcessAltReleased(GraphPanel);
+
+		if (!UAutoSizeCommentsSettings::Get().bHighlightContainingNodesOnSelection)
+		{
+			GraphData.NodeHighlight.Reset(Graph);
+		}
+	}
+
+	GraphData.bPreviousAltDown = bIsAltDown;
+
+	// update the most nested comments first, so their parents resize around their new bounds in the same pass
+	const FASCCommentContainment& Containment = GetCommentContainment(Graph);
+	TArray<TPair<int32, SAutoSizeCommentsGraphNode*>> SortedComments;
+	SortedComments.Reserve(Comments.Num());
+	for (const TSharedPtr<SAutoSizeCommentsGraphNode>& ASCComment : Comments)
+	{
+		SortedComments.Emplace(Containment.GetNestingDepth(ASCComment->GetCommentNodeObj()), ASCComment.Get());
+	}
+
+	SortedComments.StableSort([](const TPair<int32, SAutoSizeCommentsGraphNode*>& A, const TPair<int32, SAutoSizeCommentsGraphNode*>& B)
+	{
+		return A.Key > B.Key;
+	});
+
+	for (const TPair<int32, SAutoSizeCommentsGraphNode*>& Elem : SortedComments)
+	{
+		Elem.Value->UpdateComment(bCheckForInvalidNodes ? &GraphNodes : nullptr, bIsAltDown);
+	}
+}
+
+void FAutoSizeCommentGraphHandler::FindNodeGeometryChanges(TSharedPtr<SGraphPanel> GraphPanel, FASCGraphHandlerData& GraphData, TArray<UEdGraphNode*>& OutChangedNodes)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FAutoSizeCommentGraphHandler::FindNodeGeometryChanges"), STAT_ASC_FindNodeGeometryChanges, STATGROUP_AutoSizeComments);
+
+	const FASCCommentContainment& Containment = GetCommentContainment(GraphPanel->GetGraphObj());
+	FASCSpatialIndex& SpatialIndex = GetSpatialIndex(GraphPanel);
+
+	FChildren* PanelChildren = GraphPanel->GetAllChildren();
+	const int32 NumChildren = PanelChildren->Num();
+	GraphData.NodeGeometry.SetNum(NumChildren);
+
+	for (int32 NodeIndex = 0; NodeIndex < NumChildren; ++NodeIndex)
+	{
+		const TSharedRef<SGraphNode> NodeWidget = StaticCastSharedRef<SGraphNode>(PanelChildren->GetChildAt(NodeIndex));
+		const FASCVector2 Position = FASCUtils::GetNodePos(&NodeWidget.Get());
+		const FASCVector2 Size = NodeWidget->GetDesiredSize();
+
+		UEdGraphNode* Node = NodeWidget->GetNodeObj();
+
+		// the desired size is only known after the node has been painted, so this runs the frame after a change
+		FASCNodeGeometry& Geometry = GraphData.NodeGeometry[NodeIndex];
+		const bool bGeometryChanged = Geometry.Widget != NodeWidget || Geometry.Position != Position || Geometry.Size != Size;
+		if (bGeometryChanged)
+		{
+			Geometry.Widget = NodeWidget;
+			Geometry.Position = Position;
+			Geometry.Size = Size;
+
+			if (Node)
+			{
+				OutChangedNodes.Add(Node);
+
+				// desired size changes and direct writes to the node position don't go through Modify
+				SpatialIndex.MarkNodeDirty(Node);
+			}
+		}
+
+		// modified nodes are also refreshed as their comment bubble may have changed
+		if (Node && (bGeometryChanged || GraphData.BoundsCache.IsNodeDirty(Node)))
+		{
+			GraphData.BoundsCache.UpdateNodeBounds(NodeWidget.Get(), Containment);
+		}
+	}
+
+	SpatialIndex.MarkGeometrySynced();
+}
+
 void FAutoSizeCommentGraphHandler::UpdateNodeUnrelatedState()
 {
 	if (!UAutoSizeCommentsSettings::Get().bHighlightContainingNodesOnSelection)
@@ -740,11 +1150,7 @@ void FAutoSizeCommentGraphHandler::UpdateNodeUnrelatedState()
 			// if we deselected everything, clear the unrelated nodes and empty the last selection set
 			if (SelectedComments.Num() == 0 && GraphData->LastSelectionSet.Num() != 0)
 			{
-				for (UEdGraphNode* Node : Graph->Nodes)
-				{
-					Node->SetNodeUnrelated(false);
-				}
-
+				GraphData->NodeHighlight.Reset(Graph);
 				GraphData->LastSelectionSet.Empty();
 				continue;
 			}
@@ -780,20 +1186,14 @@ void FAutoSizeCommentGraphHandler::UpdateNodeUnrelatedState()
 
 			if (bRefreshSelectedNodes)
 			{
-				for (UEdGraphNode* Node : Graph->Nodes)
-				{
-					Node->SetNodeUnrelated(true);
-				}
-
+				TArray<UEdGraphNode*> RelatedNodes;
 				for (TWeakObjectPtr<UEdGraphNode_Comment> Comment : GraphData->LastSelectionSet)
 				{
-					Comment->SetNodeUnrelated(false);
-
-					for (UEdGraphNode* Node : FASCUtils::GetNodesUnderComment(Comment.Get()))
-					{
-						Node->SetNodeUnrelated(false);
-					}
+					RelatedNodes.Add(Comment.Get());
+					RelatedNodes.Append(FASCUtils::GetNodesUnderComment(Comment.Get()));
 				}
+
+				GraphData->NodeHighlight.SetRelatedNodes(Graph, RelatedNodes);
 			}
 		}
 	}
@@ -818,17 +1218,33 @@ void FAutoSizeCommentGraphHandler::UpdateGraphPurgeTimer()
 	}
 }
 
+void FAutoSizeCommentGraphHandler::SetNodesRelated(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes)
+{
+	if (Graph)
+	{
+		GetGraphHandlerData(Graph).NodeHighlight.SetRelatedNodes(Graph, Nodes);
+	}
+}
+
+bool FAutoSizeCommentGraphHandler::UpdateNodesRelated(UEdGraph* Graph, const TArray<UEdGraphNode*>& AddedNodes, const TArray<UEdGraphNode*>& RemovedNodes)
+{
+	FASCGraphHandlerData* GraphData = GraphDatas.Find(Graph);
+	return GraphData && GraphData->NodeHighlight.UpdateRelatedNodes(Graph, AddedNodes, RemovedNodes);
+}
+
+void FAutoSizeCommentGraphHandler::ResetNodesUnrelated(UEdGraph* Graph)
+{
+	if (FASCGraphHandlerData* GraphData = GraphDatas.Find(Graph))
+	{
+		GraphData->NodeHighlight.Reset(Graph);
+	}
+}
+
 void FAutoSizeCommentGraphHandler::ClearUnrelatedNodes()
 {
 	for (auto& Elem : GraphDatas)
 	{
-		if (Elem.Key.IsValid())
-		{
-			for (UEdGraphNode* NodeToUpdate : Elem.Key->Nodes)
-			{
-				NodeToUpdate->SetNodeUnrelated(false);
-			}
-		}
+		Elem.Value.NodeHighlight.Reset(Elem.Key.Get());
 	}
 }
 
@@ -914,19 +1330,31 @@ void FAutoSizeCommentGraphHandler::OnNodeDeleted(const FEdGraphEditAction& Actio
 	// remove any deleted nodes from their containing comments
 	if (Action.Graph)
 	{
-		TArray<UEdGraphNode_Comment*> Comments;
-		Action.Graph->GetNodesOfClass<UEdGraphNode_Comment>(Comments);
+		FASCCommentContainment& Containment = GetCommentContainment(const_cast<UEdGraph*>(Action.Graph));
 
-		// is there a better way of converting this set of const ptrs to non-const ptrs?
-		TSet<UObject*> NodeToRemove;
+		// only the comments containing the deleted nodes need updating
+		TMap<UEdGraphNode_Comment*, TSet<UObject*>> NodesToRemove;
 		for (const UEdGraphNode* Node : Action.Nodes)
 		{
-			NodeToRemove.Add(const_cast<UEdGraphNode*>(Node));
+			UEdGraphNode* DeletedNode = const_cast<UEdGraphNode*>(Node);
+			for (UEdGraphNode_Comment* Comment : Containment.GetContainingComments(DeletedNode))
+			{
+				NodesToRemove.FindOrAdd(Comment).Add(DeletedNode);
+			}
+		}
+
+		for (const auto& Kvp : NodesToRemove)
+		{
+			FASCUtils::RemoveNodesFromComment(Kvp.Key, Kvp.Value);
 		}
 
-		for (UEdGraphNode_Comment* Comment : Comments)
+		// deleted comments no longer contain anything
+		for (const UEdGraphNode* Node : Action.Nodes)
 		{
-			FASCUtils::RemoveNodesFromComment(Comment, NodeToRemove);
+			if (const UEdGraphNode_Comment* DeletedComment = Cast<UEdGraphNode_Comment>(Node))
+			{
+				Containment.OnCommentCleared(const_cast<UEdGraphNode_Comment*>(DeletedComment));
+			}
 		}
 	}
 
@@ -954,10 +1382,7 @@ void FAutoSizeCommentGraphHandler::OnNodeDeleted(const FEdGraphEditAction& Actio
 
 	if (bResetUnrelatedNodes)
 	{
-		for (UEdGraphNode* NodeToUpdate : Action.Graph->Nodes)
-		{
-			NodeToUpdate->SetNodeUnrelated(false);
-		}
+		ResetNodesUnrelated(Action.Graph);
 	}
 }
 
@@ -988,6 +1413,8 @@ void FAutoSizeCommentGraphHandler::OnObjectSaved(UObject* Object)
 		TArray<UEdGraphNode_Comment*> Comments;
 		Graph->GetNodesOfClassEx<UEdGraphNode_Comment>(Comments);
 
+		FAutoSizeCommentsCacheFile::Get().QueuePackageSave(Graph);
+
 		if (!bPendingSave)
 		{
 			bPendingSave = true;
@@ -1014,6 +1441,18 @@ void FAutoSizeCommentGraphHandler::OnObjectTransacted(UObject* Object, const FTr
 		return;
 	}
 
+	// a moved material comment dirties its material once the move has been transacted
+	if (Event.GetEventType() == ETransactionObjectEventType::Finalized)
+	{
+		if (UEdGraphNode_Comment* Comment = Cast<UEdGraphNode_Comment>(Object))
+		{
+			if (TSharedPtr<SAutoSizeCommentsGraphNode> ASCComment = FASCState::Get().GetASCComment(Comment))
+			{
+				ASCComment->FlushMaterialDirty();
+			}
+		}
+	}
+
 	// we are probably currently dragging a node around so don't update now
 	if (FSlateApplication::Get().GetModifierKeys().IsAltDown())
 	{
@@ -1023,56 +1462,196 @@ void FAutoSizeCommentGraphHandler::OnObjectTransacted(UObject* Object, const FTr
 	if (Event.GetEventType() == ETransactionObjectEventType::UndoRedo ||
 		Event.GetEventType() == ETransactionObjectEventType::Finalized)
 	{
+		// undo can add or remove nodes without notifying the graph
+		if (UEdGraph* Graph = Cast<UEdGraph>(Object))
+		{
+			if (FASCGraphHandlerData* GraphData = GraphDatas.Find(Graph))
+			{
+				GraphData->bCheckForInvalidNodes = true;
+				GraphData->bGuidToNodeDirty = true;
+				GraphData->CommentContainment.Invalidate();
+				GraphData->CommentBroadphase.Invalidate();
+			}
+
+			InvalidateSpatialIndices(Graph);
+		}
+
 		if (UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
 		{
+			MarkNodeModified(Node);
+
+			// the nodes under a comment are not transacted, so the hierarchy may be out of date after undo
+			if (Node->IsA<UEdGraphNode_Comment>())
+			{
+				if (FASCGraphHandlerData* GraphData = GraphDatas.Find(Node->GetGraph()))
+				{
+					GraphData->CommentContainment.Invalidate();
+					GraphData->CommentBroadphase.Invalidate();
+				}
+			}
+
 			if (GetResizingMode(Node->GetGraph()) != EASCResizingMode::Disabled)
 			{
-				GEditor->GetTimerManager()->SetTimerForNextTick(FTimerDelegate::CreateRaw(this, &FAutoSizeCommentGraphHandler::UpdateContainingComments, TWeakObjectPtr<UEdGraphNode>(Node)));
+				// a single undo can transact hundreds of nodes, so they are resized together on the next frame
+				if (FASCGraphHandlerData* GraphData = GraphDatas.Find(Node->GetGraph()))
+				{
+					FASCDeferredGraphWork::QueueNode(GraphData->DeferredWork.TransactedNodes, Node);
+				}
 			}
 		}
 		
 	}
 }
 
+void FAutoSizeCommentGraphHandler::OnObjectModified(UObject* Object)
+{
+	// moving a node (SGraphNode::MoveTo), linking pins and editing pin values all modify the node
+	if (UEdGraphNode* Node = Cast<UEdGraphNode>(Object))
+	{
+		MarkNodeModified(Node);
+	}
+}
+
 void FAutoSizeCommentGraphHandler::OnPostGarbageCollect()
 {
 	// cleanup invalid graphs
 	GraphDatas.Remove(nullptr);
+
+	for (auto& Elem : GraphDatas)
+	{
+		Elem.Value.NodeChangeStore.RemoveInvalidNodes();
+		Elem.Value.BoundsCache.RemoveInvalidNodes();
+	}
+
+	for (auto Iter = SpatialIndices.CreateIterator(); Iter; ++Iter)
+	{
+		if (!Iter.Key().IsValid())
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+
+	for (auto Iter = SpatialIndexPanels.CreateIterator(); Iter; ++Iter)
+	{
+		Iter.Value().RemoveAll([](const TWeakPtr<SGraphPanel>& Panel) { return !Panel.IsValid(); });
+		if (!Iter.Key().IsValid() || Iter.Value().Num() == 0)
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+}
+
+void FAutoSizeCommentGraphHandler::InvalidateSpatialIndices(UEdGraph* Graph)
+{
+	for (FASCSpatialIndex* SpatialIndex : FindSpatialIndices(Graph))
+	{
+		SpatialIndex->Invalidate();
+	}
 }
 
 void FAutoSizeCommentGraphHandler::SaveSizeCache()
 {
-	FAutoSizeCommentsCacheFile::Get().SaveCacheToFile();
+	FAutoSizeCommentsCacheFile::Get().SaveQueuedPackages();
 	bPendingSave = false;
 }
 
-void FAutoSizeCommentGraphHandler::UpdateContainingComments(TWeakObjectPtr<UEdGraphNode> Node)
+void FASCDeferredGraphWork::QueueNode(TMap<TWeakObjectPtr<UEdGraphNode>, FASCDeferredNode>& Queue, UEdGraphNode* Node)
+{
+	FASCDeferredNode& Entry = Queue.FindOrAdd(Node);
+	Entry.Frame = GFrameCounter;
+	++Entry.NumEvents;
+}
+
+void FAutoSizeCommentGraphHandler::ProcessDeferredWork()
 {
-	if (!Node.IsValid() || !IsValid(Node.Get()))
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FAutoSizeCommentGraphHandler::ProcessDeferredWork"), STAT_ASC_ProcessDeferredWork, STATGROUP_AutoSizeComments);
+
+	int32 NumCoalesced = 0;
+
+	// OnNodeAdded can bind new graphs, so gather the graphs with work first
+	TArray<TWeakObjectPtr<UEdGraph>, TInlineAllocator<4>> GraphsWithWork;
+	for (const auto& Elem : GraphDatas)
 	{
-		return;
+		if (!Elem.Value.DeferredWork.IsEmpty())
+		{
+			GraphsWithWork.Add(Elem.Key);
+		}
+	}
+
+	for (const TWeakObjectPtr<UEdGraph>& GraphPtr : GraphsWithWork)
+	{
+		FASCGraphHandlerData* GraphData = GraphDatas.Find(GraphPtr);
+		UEdGraph* Graph = GraphPtr.Get();
+		if (!GraphData || !IsValid(Graph))
+		{
+			continue;
+		}
+
+		// take the nodes queued before this frame, anything queued this frame waits for the next one
+		const auto TakeReadyNodes = [&NumCoalesced](TMap<TWeakObjectPtr<UEdGraphNode>, FASCDeferredNode>& Queue, TArray<UEdGraphNode*>& OutNodes)
+		{
+			for (auto Iter = Queue.CreateIterator(); Iter; ++Iter)
+			{
+				if (Iter.Value().Frame < GFrameCounter)
+				{
+					if (UEdGraphNode* Node = Iter.Key().Get())
+					{
+						OutNodes.Add(Node);
+					}
+
+					// the node is processed once for all of its events
+					NumCoalesced += Iter.Value().NumEvents - 1;
+
+					Iter.RemoveCurrent();
+				}
+			}
+		};
+
+		TArray<UEdGraphNode*> AddedNodes;
+		TArray<UEdGraphNode*> TransactedNodes;
+		TakeReadyNodes(GraphData->DeferredWork.AddedNodes, AddedNodes);
+		TakeReadyNodes(GraphData->DeferredWork.TransactedNodes, TransactedNodes);
+
+		if (AddedNodes.Num() == 0 && TransactedNodes.Num() == 0)
+		{
+			continue;
+		}
+
+		UpdateContainingComments(Graph, TransactedNodes);
+
+		for (UEdGraphNode* AddedNode : AddedNodes)
+		{
+			OnNodeAdded(AddedNode);
+		}
 	}
 
-	UEdGraph* Graph = Node->GetGraph();
-	if (!IsValid(Graph))
+	SET_DWORD_STAT(STAT_ASC_CoalescedGraphEvents, NumCoalesced);
+}
+
+void FAutoSizeCommentGraphHandler::UpdateContainingComments(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes)
+{
+	if (Nodes.Num() == 0 || !IsValid(Graph))
 	{
 		return;
 	}
 
-	TArray<UEdGraphNode_Comment*> Comments;
+	// gather the comments first so each comment is only resized once
+	const FASCCommentContainment& Containment = GetCommentContainment(Graph);
+	TSet<UEdGraphNode_Comment*> CommentsToResize;
+	for (UEdGraphNode* Node : Nodes)
+	{
+		if (IsValid(Node) && Node->GetGraph() == Graph)
+		{
+			CommentsToResize.Append(Containment.GetContainingComments(Node));
+		}
+	}
 
-	// check if any node on the graph contains the new node
-	Graph->GetNodesOfClass<UEdGraphNode_Comment>(Comments);
-	for (UEdGraphNode_Comment* Comment : Comments)
+	// resize the comments containing the nodes
+	for (UEdGraphNode_Comment* Comment : CommentsToResize)
 	{
 		if (TSharedPtr<SAutoSizeCommentsGraphNode> ASCComment = FASCState::Get().GetASCComment(Comment))
 		{
-			TArray<UEdGraphNode*> NodesUnderComment;
-			FAutoSizeCommentsCacheFile::Get().GetNodesUnderComment(ASCComment, NodesUnderComment);
-			if (NodesUnderComment.Contains(Node))
-			{
-				ASCComment->ResizeToFit();
-			}
+			ASCComment->ResizeToFit();
 		}
 	}
 }
@@ -4,6 +4,7 @@
 
 #include "AutoSizeCommentsCacheFile.h"
 #include "AutoSizeCommentsGraphHandler.h"
+#include "AutoSizeCommentsSpatialIndex.h"
 #include "AutoSizeCommentsInputProcessor.h"
 #include "AutoSizeCommentsModule.h"
 #include "AutoSizeCommentsSettings.h"
@@ -77,6 +78,8 @@ void SAutoSizeCommentsGraphNode::Construct(const FArguments& InArgs, class UEdGr
 
 SAutoSizeCommentsGraphNode::~SAutoSizeCommentsGraphNode()
 {
+	FASCState::Get().RemovePanelComment(RegisteredPanel.Pin(), this);
+
 	if (!bInitialized)
 	{
 		return;
@@ -179,6 +182,10 @@ void SAutoSizeCommentsGraphNode::MoveTo(const FASCVector2& NewPosition, FNodeSet
 		}
 	}
 
+	// the comment is placed again once it is dropped
+	bRequestEmptyPlacement = true;
+	PlacementAlpha = 1.0f;
+
 	const FASCVector2 PositionDelta = NewPosition - GetPos();
 	SGraphNode::MoveTo(NewPosition, NodeFilter, bMarkDirty);
 
@@ -188,9 +195,7 @@ void SAutoSizeCommentsGraphNode::MoveTo(const FASCVector2& NewPosition, FNodeSet
 	if (KeysState.IsAltDown() && AltCollisionMethod != ECommentCollisionMethod::Disabled)
 	{
 		// still update collision when we alt-control drag
-		TArray<UEdGraphNode*> NodesUnderComment;
-		QueryNodesUnderComment(NodesUnderComment, AltCollisionMethod);
-		SetNodesRelated(NodesUnderComment);
+		RequestRelatedNodesQuery(AltCollisionMethod);
 	}
 	else if (IsSingleSelectedNode())
 	{
@@ -207,30 +212,34 @@ void SAutoSizeCommentsGraphNode::MoveTo(const FASCVector2& NewPosition, FNodeSet
 		{
 			// Now update any nodes which are touching the comment but *not* selected
 			// Selected nodes will be moved as part of the normal selection code
-			TSharedPtr<SGraphPanel> Panel = GetOwnerPanel();
+			const bool bIsInteractiveDrag = FSlateApplication::Get().GetPressedMouseButtons().Contains(EKeys::LeftMouseButton);
+			if (!bIsInteractiveDrag || !bHasDragClosure)
+			{
+				BuildDragClosure();
+				bHasDragClosure = bIsInteractiveDrag;
+			}
 
-			for (FCommentNodeSet::TConstIterator NodeIt(CommentNode->GetNodesUnderComment()); NodeIt; ++NodeIt)
+			for (const FASCDragNode& DragNode : DragClosure)
 			{
-				if (UEdGraphNode* Node = Cast<UEdGraphNode>(*NodeIt))
+				UEdGraphNode* Node = DragNode.Node.Get();
+				if (!Node || NodeFilter.Contains(DragNode.Widget))
 				{
-					if (!Panel->SelectionManager.IsNodeSelected(Node))
-					{
-						if (TSharedPtr<SGraphNode> PanelGraphNode = FASCUtils::GetGraphNode(Panel, Node))
-						{
-							if (!NodeFilter.Find(PanelGraphNode))
-							{
-								NodeFilter.Add(PanelGraphNode);
+					continue;
+				}
+
+				NodeFilter.Add(DragNode.Widget);
 #if ASC_UE_VERSION_OR_LATER(4, 27)
-								Node->Modify(bMarkDirty);
+				Node->Modify(bMarkDirty);
 #else
-								Node->Modify();
+				Node->Modify();
 #endif
-								Node->NodePosX += PositionDelta.X;
-								Node->NodePosY += PositionDelta.Y;
-							}
-						}
-					}
-				}
+				Node->NodePosX += PositionDelta.X;
+				Node->NodePosY += PositionDelta.Y;
+			}
+
+			if (!bIsInteractiveDrag)
+			{
+				DragClosure.Reset();
 			}
 		}
 	}
@@ -240,11 +249,61 @@ void SAutoSizeCommentsGraphNode::MoveTo(const FASCVector2& NewPosition, FNodeSet
 	{
 		MaterialComment->MaterialExpressionComment->MaterialExpressionEditorX = CommentNode->NodePosX;
 		MaterialComment->MaterialExpressionComment->MaterialExpressionEditorY = CommentNode->NodePosY;
+
+		// dirtying the material is expensive, so only do it once the drag has finished
+		bPendingMaterialDirty = true;
+		if (!FSlateApplication::Get().GetPressedMouseButtons().Contains(EKeys::LeftMouseButton))
+		{
+			FlushMaterialDirty();
+		}
+	}
+}
+
+void SAutoSizeCommentsGraphNode::FlushMaterialDirty()
+{
+	if (!bPendingMaterialDirty)
+	{
+		return;
+	}
+
+	bPendingMaterialDirty = false;
+
+	UMaterialGraphNode_Comment* MaterialComment = Cast<UMaterialGraphNode_Comment>(CommentNode);
+	if (IsValid(MaterialComment) && MaterialComment->MaterialExpressionComment)
+	{
 		MaterialComment->MaterialExpressionComment->MarkPackageDirty();
 		MaterialComment->MaterialDirtyDelegate.ExecuteIfBound();
 	}
 }
 
+void SAutoSizeCommentsGraphNode::BuildDragClosure()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SAutoSizeCommentsGraphNode::BuildDragClosure"), STAT_ASC_BuildDragClosure, STATGROUP_AutoSizeComments);
+
+	DragClosure.Reset();
+
+	TSharedPtr<SGraphPanel> Panel = GetOwnerPanel();
+	if (!Panel)
+	{
+		return;
+	}
+
+	// the nodes under the comment already include the nodes under any nested comments
+	for (UObject* Obj : CommentNode->GetNodesUnderComment())
+	{
+		UEdGraphNode* Node = Cast<UEdGraphNode>(Obj);
+		if (!Node || Panel->SelectionManager.IsNodeSelected(Node))
+		{
+			continue;
+		}
+
+		if (TSharedPtr<SGraphNode> PanelGraphNode = FASCUtils::GetGraphNode(Panel, Node))
+		{
+			DragClosure.Add(FASCDragNode{ Node, PanelGraphNode.ToSharedRef() });
+		}
+	}
+}
+
 FReply SAutoSizeCommentsGraphNode::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
 {
 	if (!IsEditable.Get())
@@ -259,6 +318,7 @@ FReply SAutoSizeCommentsGraphNode::OnMouseButtonDown(const FGeometry& MyGeometry
 		{
 			DragSize = UserSize;
 			bUserIsDragging = true;
+			ClearRelatedNodesQuery();
 
 			// deselect all nodes when we are trying to resize
 			GetOwnerPanel()->SelectionManager.ClearSelectionSet();
@@ -288,6 +348,7 @@ FReply SAutoSizeCommentsGraphNode::OnMouseButtonUp(const FGeometry& MyGeometry,
 {
 	if (bUserIsDragging)
 	{
+		ClearRelatedNodesQuery();
 		ResetNodesUnrelated();
 	}
 
@@ -378,9 +439,7 @@ FReply SAutoSizeCommentsGraphNode::OnMouseMove(const FGeometry& MyGeometry, cons
 		}
 
 #if ASC_UE_VERSION_OR_LATER(4, 23)
-		TArray<UEdGraphNode*> Nodes;
-		QueryNodesUnderComment(Nodes, UAutoSizeCommentsSettings::Get().ResizeCollisionMethod);
-		SetNodesRelated(Nodes);
+		RequestRelatedNodesQuery(UAutoSizeCommentsSettings::Get().ResizeCollisionMethod);
 #endif
 	}
 
@@ -422,77 +481,44 @@ void SAutoSizeCommentsGraphNode::Tick(const FGeometry& AllottedGeometry, const d
 		return;
 	}
 
-	if (FASCUtils::IsGraphReadOnly(GetOwnerPanel()))
-	{
-		return;
-	}
-
-	const UAutoSizeCommentsSettings& ASCSettings = UAutoSizeCommentsSettings::Get();
-
-	bAreControlsEnabled = !AreResizeModifiersDown(false) && (!UAutoSizeCommentsSettings::Get().EnableCommentControlsKey.Key.IsValid() || bAreControlsEnabled);
+	// resizing and collision is handled by the graph handler, which only updates comments that are being ticked
+	LastTickFrame = GFrameCounter;
 
-	// We need to call this on tick since there are quite a few methods of deleting
-	// nodes without any callbacks (undo, collapse to function / macro...)
-	RemoveInvalidNodes();
-
-	const EASCResizingMode ResizingMode = GetResizingMode();
-
-	if (ResizingMode == EASCResizingMode::Disabled)
-	{
-		UserSize.X = CommentNode->NodeWidth;
-		UserSize.Y = CommentNode->NodeHeight;
-	}
-
-	if (TwoPassResizeDelay > 0)
+	if (PendingRelatedQuery.IsSet())
 	{
-		if (--TwoPassResizeDelay == 0)
+		// the alt key may have been released since the query was requested
+		if (bUserIsDragging || FSlateApplication::Get().GetModifierKeys().IsAltDown())
 		{
-			ResizeToFit_Impl();
+			UpdateRelatedNodesQuery(PendingRelatedQuery.GetValue());
 		}
+
+		PendingRelatedQuery.Reset();
 	}
 
-	if (!IsHeaderComment() && !bUserIsDragging)
+	// the drag closure and material dirtying are only deferred until the mouse is released
+	if ((bHasDragClosure || bPendingMaterialDirty) && !FSlateApplication::Get().GetPressedMouseButtons().Contains(EKeys::LeftMouseButton))
 	{
-		const FModifierKeysState& KeysState = FSlateApplication::Get().GetModifierKeys();
-
-		const bool bIsAltDown = KeysState.IsAltDown();
-		if (!bIsAltDown)
-		{
-			const ECommentCollisionMethod& AltCollisionMethod = UAutoSizeCommentsSettings::Get().AltCollisionMethod;
-
-			// still update collision when we alt-control drag
-			const bool bUseAltCollision = AltCollisionMethod != ECommentCollisionMethod::Disabled;
+		DragClosure.Reset();
+		bHasDragClosure = false;
+		FlushMaterialDirty();
+	}
 
-			// refresh when the alt key is released
-			if (bPreviousAltDown && bUseAltCollision)
-			{
-				OnAltReleased();
-			}
+	if (FASCUtils::IsGraphReadOnly(GetOwnerPanel()))
+	{
+		return;
+	}
 
-			if (ResizingMode == EASCResizingMode::Always)
-			{
-				ResizeToFit();
-			}
-			else if (ResizingMode == EASCResizingMode::Reactive &&
-				FAutoSizeCommentGraphHandler::Get().HasCommentChanged(CommentNode))
-			{
-				FAutoSizeCommentGraphHandler::Get().UpdateCommentChangeState(CommentNode);
-				ResizeToFit();
-			}
+	const UAutoSizeCommentsSettings& ASCSettings = UAutoSizeCommentsSettings::Get();
 
-			MoveEmptyCommentBoxes();
+	bAreControlsEnabled = !AreResizeModifiersDown(false) && (!UAutoSizeCommentsSettings::Get().EnableCommentControlsKey.Key.IsValid() || bAreControlsEnabled);
 
-			// if (ResizeTransaction.IsValid())
-			// {
-			// 	ResizeTransaction.Reset();
-			// }
-		}
+	SGraphNode::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
 
-		bPreviousAltDown = bIsAltDown;
+	if (PlacementAlpha < 1.0f)
+	{
+		UpdatePlacementAnimation(InDeltaTime);
 	}
 
-	SGraphNode::Tick(AllottedGeometry, InCurrentTime, InDeltaTime);
-
 	if (IsHeaderComment())
 	{
 		UserSize.Y = GetTitleBarHeight();
@@ -514,11 +540,6 @@ void SAutoSizeCommentsGraphNode::Tick(const FGeometry& AllottedGeometry, const d
 		CachedWidth = CurrentWidth;
 	}
 
-	if (UAutoSizeCommentsSubsystem::Get().IsDirty(CommentNode))
-	{
-		UpdateCache();
-	}
-
 	// Otherwise update when cached values have changed
 	if (bCachedBubbleVisibility != CommentNode->bCommentBubbleVisible_InDetailsPanel)
 	{
@@ -549,6 +570,68 @@ void SAutoSizeCommentsGraphNode::Tick(const FGeometry& AllottedGeometry, const d
 	UpdateColors(InDeltaTime);
 }
 
+void SAutoSizeCommentsGraphNode::UpdateComment(const TSet<UEdGraphNode*>* GraphNodes, const bool bIsAltDown)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SAutoSizeCommentsGraphNode::UpdateComment"), STAT_ASC_UpdateComment, STATGROUP_AutoSizeComments);
+
+	// GraphNodes is only passed when the graph has changed, as there are quite a few methods
+	// of deleting nodes without any node callbacks (undo, collapse to function / macro...)
+	if (GraphNodes)
+	{
+		RemoveInvalidNodes(*GraphNodes);
+	}
+
+	const EASCResizingMode ResizingMode = GetResizingMode();
+
+	if (ResizingMode == EASCResizingMode::Disabled)
+	{
+		UserSize.X = CommentNode->NodeWidth;
+		UserSize.Y = CommentNode->NodeHeight;
+	}
+
+	if (!IsHeaderComment() && !bUserIsDragging && !bIsAltDown)
+	{
+		if (ResizingMode == EASCResizingMode::Always)
+		{
+			ResizeToFit();
+		}
+		else if (ResizingMode == EASCResizingMode::Reactive)
+		{
+			// resize once when the nodes have moved or resized on screen, or when nodes are added or removed
+			bool bShouldResize = bGeometryChanged;
+			bGeometryChanged = false;
+
+			// only comments flagged by the graph handler need to check their nodes for changes
+			const bool bCheckForChanges = bNodesModified;
+			bNodesModified = false;
+
+			if (bCheckForChanges && FAutoSizeCommentGraphHandler::Get().HasCommentChanged(CommentNode))
+			{
+				FAutoSizeCommentGraphHandler::Get().UpdateCommentChangeState(CommentNode);
+				bShouldResize = true;
+			}
+
+			if (bShouldResize)
+			{
+				ResizeToFit();
+			}
+		}
+
+		MoveEmptyCommentBoxes();
+	}
+
+	if (UAutoSizeCommentsSubsystem::Get().IsDirty(CommentNode))
+	{
+		UpdateCache();
+	}
+}
+
+bool SAutoSizeCommentsGraphNode::ShouldUpdateComment() const
+{
+	// slate only ticks widgets which are being painted, so skip comments in closed or hidden graphs
+	return bInitialized && GFrameCounter - LastTickFrame <= 1;
+}
+
 void SAutoSizeCommentsGraphNode::UpdateGraphNode()
 {
 	const UAutoSizeCommentsSettings& ASCSettings = UAutoSizeCommentsSettings::Get();
@@ -766,11 +849,20 @@ void SAutoSizeCommentsGraphNode::SetOwner(const TSharedRef<SGraphPanel>& OwnerPa
 {
 	SGraphNode::SetOwner(OwnerPanel);
 
+	if (RegisteredPanel.IsValid())
+	{
+		FASCState::Get().RemovePanelComment(RegisteredPanel.Pin(), this);
+		RegisteredPanel.Reset();
+	}
+
 	if (!IsValidGraphPanel(OwnerPanel))
 	{
 		return;
 	}
 
+	RegisteredPanel = OwnerPanel;
+	FASCState::Get().AddPanelComment(OwnerPanel, SharedThis(this));
+
 	TArray<TWeakObjectPtr<UObject>> InitialSelectedNodes;
 	for (UObject* SelectedNode : OwnerPanel->SelectionManager.GetSelectedNodes())
 	{
@@ -843,6 +935,7 @@ void SAutoSizeCommentsGraphNode::InitializeASCNode(const TArray<TWeakObjectPtr<U
 		if (!CommentData.HasBeenInitialized())
 		{
 			CommentData.SetInitialized(true);
+			FAutoSizeCommentsCacheFile::Get().MarkCommentDirty(CommentNode);
 
 			// don't initialize without any selected nodes!
 			const bool bShouldApplyColor = !bHasBeenCopyPasted && (!IsExistingComment() || UAutoSizeCommentsSettings::Get().bApplyColorToExistingNodes);
@@ -1155,13 +1248,11 @@ bool SAutoSizeCommentsGraphNode::IsValidGraphPanel(TSharedPtr<SGraphPanel> Graph
 	return true;
 }
 
-void SAutoSizeCommentsGraphNode::RemoveInvalidNodes()
+void SAutoSizeCommentsGraphNode::RemoveInvalidNodes(const TSet<UEdGraphNode*>& GraphNodes)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SAutoSizeCommentsGraphNode::RemoveInvalidNodes"), STAT_ASC_RemoveInvalidNodes, STATGROUP_AutoSizeComments);
 	const TArray<UObject*>& UnfilteredNodesUnderComment = CommentNode->GetNodesUnderComment();
 
-	const TArray<UEdGraphNode*>& GraphNodes = GetOwnerPanel()->GetGraphObj()->Nodes;
-
 	// Remove all invalid objects
 	TSet<UObject*> InvalidObjects;
 	for (UObject* Obj : UnfilteredNodesUnderComment)
@@ -1171,7 +1262,7 @@ void SAutoSizeCommentsGraphNode::RemoveInvalidNodes()
 
 		// If a node gets deleted it can still stay inside the comment box
 		// So checks if the node is still on the graph
-		if (!GraphNodes.Contains(Obj))
+		if (!GraphNodes.Contains(Cast<UEdGraphNode>(Obj)))
 		{
 			InvalidObjects.Add(Obj);
 		}
@@ -1315,9 +1406,6 @@ void SAutoSizeCommentsGraphNode::UpdateExistingCommentNodes(const TArray<UEdGrap
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SAutoSizeCommentsGraphNode::UpdateExistingCommentNodes"), STAT_ASC_UpdateExistingCommentNodes, STATGROUP_AutoSizeComments);
 
-	// Get list of all other comment nodes
-	TSet<TSharedPtr<SAutoSizeCommentsGraphNode>> OtherCommentNodes = GetOtherCommentNodes();
-
 	TArray<UObject*> OurMainNodes = CommentNode->GetNodesUnderComment().FilterByPredicate(IsMajorNode);
 
 	TArray<UEdGraphNode_Comment*> CurrentParentComments = GetParentComments();
@@ -1360,11 +1448,12 @@ void SAutoSizeCommentsGraphNode::UpdateExistingCommentNodes(const TArray<UEdGrap
 	}
 
 	bool bNeedsPurging = false;
-	for (TSharedPtr<SAutoSizeCommentsGraphNode> OtherCommentNode : OtherCommentNodes)
+	for (const TWeakPtr<SAutoSizeCommentsGraphNode>& OtherCommentPtr : FASCState::Get().GetPanelComments(RegisteredPanel.Pin()))
 	{
-		UEdGraphNode_Comment* OtherComment = OtherCommentNode->GetCommentNodeObj();
-
-		if (OtherComment == CommentNode)
+		// skip ourselves, invalid comments and widgets which were created but never initialized
+		TSharedPtr<SAutoSizeCommentsGraphNode> OtherCommentNode = OtherCommentPtr.Pin();
+		UEdGraphNode_Comment* OtherComment = OtherCommentNode ? OtherCommentNode->GetCommentNodeObj() : nullptr;
+		if (!IsValid(OtherComment) || OtherComment == CommentNode || !OtherCommentNode->bInitialized)
 		{
 			continue;
 		}
@@ -1500,11 +1589,6 @@ FASCCommentData& SAutoSizeCommentsGraphNode::GetCommentData() const
 void SAutoSizeCommentsGraphNode::ResizeToFit()
 {
 	ResizeToFit_Impl();
-
-	if (UAutoSizeCommentsSettings::Get().bUseTwoPassResize && GetResizingMode() == EASCResizingMode::Reactive)
-	{
-		TwoPassResizeDelay = 2;
-	}
 }
 
 void SAutoSizeCommentsGraphNode::ResizeToFit_Impl()
@@ -1533,10 +1617,12 @@ void SAutoSizeCommentsGraphNode::ResizeToFit_Impl()
 		FASCVector2 CurrSize = Bounds.GetSize();
 		CurrSize.Y += TitleBarHeight;
 
+		bool bBoundsChanged = false;
 		if (!UserSize.Equals(CurrSize, .1f))
 		{
 			UserSize = CurrSize;
 			GetNodeObj()->ResizeNode(CurrSize);
+			bBoundsChanged = true;
 		}
 
 		// check if location has changed
@@ -1548,6 +1634,17 @@ void SAutoSizeCommentsGraphNode::ResizeToFit_Impl()
 		{
 			GraphNode->NodePosX = DesiredPos.X;
 			GraphNode->NodePosY = DesiredPos.Y;
+			bBoundsChanged = true;
+		}
+
+		// let any parent comments see our new bounds this frame
+		if (bBoundsChanged)
+		{
+			ResizedPos = GetPos();
+			ResizedSize = UserSize;
+			bHasResizedGeometry = true;
+
+			FAutoSizeCommentGraphHandler::Get().UpdateNodeBounds(*this);
 		}
 	}
 	else
@@ -1687,82 +1784,76 @@ void SAutoSizeCommentsGraphNode::OnTitleChanged(const FString& OldTitle, const F
 
 void SAutoSizeCommentsGraphNode::MoveEmptyCommentBoxes()
 {
-	TArray<UObject*> UnderComment = CommentNode->GetNodesUnderComment();
-
-	TSharedPtr<SGraphPanel> OwnerPanel = OwnerGraphPanelPtr.Pin();
-
-	bool bIsSelected = OwnerPanel->SelectionManager.IsNodeSelected(GraphNode);
-
-	bool bIsContained = false;
-	for (TSharedPtr<SAutoSizeCommentsGraphNode> OtherCommentNode : GetOtherCommentNodes())
+	const bool bIsEmpty = CommentNode->GetNodesUnderComment().Num() == 0;
+	if (bIsEmpty && !bWasEmpty)
 	{
-		UEdGraphNode_Comment* OtherComment = OtherCommentNode->GetCommentNodeObj();
-
-		if (OtherComment->GetNodesUnderComment().Contains(CommentNode))
-		{
-			bIsContained = true;
-			break;
-		}
+		bRequestEmptyPlacement = true;
 	}
 
-	// if the comment node is empty, move away from other comment nodes
-	if (UnderComment.Num() == 0 && UAutoSizeCommentsSettings::Get().bMoveEmptyCommentBoxes && !bIsSelected && !bIsContained && !IsHeaderComment())
+	bWasEmpty = bIsEmpty;
+
+	// wait until the comment has been dropped
+	if (!bRequestEmptyPlacement || FSlateApplication::Get().GetPressedMouseButtons().Contains(EKeys::LeftMouseButton))
 	{
-		FASCVector2 TotalMovement(0, 0);
+		return;
+	}
 
-		bool bAnyCollision = false;
+	bRequestEmptyPlacement = false;
 
-		for (TSharedPtr<SAutoSizeCommentsGraphNode> OtherCommentNode : GetOtherCommentNodes())
-		{
-			if (OtherCommentNode->IsHeaderComment())
-			{
-				continue;
-			}
+	if (!bIsEmpty || !UAutoSizeCommentsSettings::Get().bMoveEmptyCommentBoxes || IsHeaderComment())
+	{
+		return;
+	}
 
-			UEdGraphNode_Comment* OtherComment = OtherCommentNode->GetCommentNodeObj();
+	if (FAutoSizeCommentGraphHandler::Get().GetCommentContainment(CommentNode->GetGraph()).IsContained(CommentNode))
+	{
+		return;
+	}
 
-			if (OtherComment->GetNodesUnderComment().Contains(CommentNode))
-			{
-				continue;
-			}
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SAutoSizeCommentsGraphNode::MoveEmptyCommentBoxes"), STAT_ASC_MoveEmptyCommentBoxes, STATGROUP_AutoSizeComments);
 
-			FSlateRect OtherBounds = GetCommentBounds(OtherComment);
-			FSlateRect MyBounds = GetCommentBounds(CommentNode);
+	FASCCommentBroadphase& Broadphase = FAutoSizeCommentGraphHandler::Get().GetCommentBroadphase(CommentNode->GetGraph());
 
-			if (FSlateRect::DoRectanglesIntersect(OtherBounds, MyBounds))
-			{
-				float DeltaLeft = OtherBounds.Left - MyBounds.Right;
-				float DeltaRight = OtherBounds.Right - MyBounds.Left;
+	FASCVector2 Offset;
+	if (!Broadphase.FindFreeOffset(GetCommentBounds(CommentNode), CommentNode, Offset) || Offset.IsNearlyZero())
+	{
+		return;
+	}
 
-				float DeltaTop = OtherBounds.Top - MyBounds.Bottom;
-				float DeltaBottom = OtherBounds.Bottom - MyBounds.Top;
+	const FASCVector2 CurrentPos(GraphNode->NodePosX, GraphNode->NodePosY);
+	PlacementTarget = FASCVector2(FMath::RoundToInt(CurrentPos.X + Offset.X), FMath::RoundToInt(CurrentPos.Y + Offset.Y));
 
-				float SelectedX = FMath::Abs(DeltaLeft) < FMath::Abs(DeltaRight) ? DeltaLeft : DeltaRight;
-				float SelectedY = FMath::Abs(DeltaTop) < FMath::Abs(DeltaBottom) ? DeltaTop : DeltaBottom;
+	GraphNode->Modify();
 
-				if (FMath::Abs(SelectedX) < FMath::Abs(SelectedY))
-				{
-					TotalMovement.X += FMath::Sign(SelectedX);
-				}
-				else
-				{
-					TotalMovement.Y += FMath::Sign(SelectedY);
-				}
+	if (UAutoSizeCommentsSettings::Get().EmptyCommentBoxAnimationTime > 0)
+	{
+		PlacementStart = CurrentPos;
+		PlacementAlpha = 0.0f;
+	}
+	else
+	{
+		GraphNode->NodePosX = FMath::RoundToInt(PlacementTarget.X);
+		GraphNode->NodePosY = FMath::RoundToInt(PlacementTarget.Y);
+		FAutoSizeCommentGraphHandler::Get().MarkNodeModified(GraphNode);
+	}
 
-				bAnyCollision = true;
-			}
-		}
+	// other comments placed this frame should avoid our new position
+	Broadphase.UpdateComment(CommentNode, FSlateRect::FromPointAndExtent(PlacementTarget, FASCVector2(CommentNode->NodeWidth, CommentNode->NodeHeight)));
+}
 
-		if (TotalMovement.SizeSquared() == 0 && bAnyCollision)
-		{
-			TotalMovement.X = (FMath::Rand() % 2) * 2 - 1;
-			TotalMovement.Y = (FMath::Rand() % 2) * 2 - 1;
-		}
+void SAutoSizeCommentsGraphNode::UpdatePlacementAnimation(float DeltaTime)
+{
+	const float AnimationTime = UAutoSizeCommentsSettings::Get().EmptyCommentBoxAnimationTime;
+	PlacementAlpha = AnimationTime > 0 ? FMath::Min(PlacementAlpha + DeltaTime / AnimationTime, 1.0f) : 1.0f;
 
-		TotalMovement *= UAutoSizeCommentsSettings::Get().EmptyCommentBoxSpeed;
+	const FASCVector2 NewPos = FMath::InterpEaseOut(PlacementStart, PlacementTarget, PlacementAlpha, 2.0f);
+	GraphNode->NodePosX = FMath::RoundToInt(NewPos.X);
+	GraphNode->NodePosY = FMath::RoundToInt(NewPos.Y);
 
-		GraphNode->NodePosX += TotalMovement.X;
-		GraphNode->NodePosY += TotalMovement.Y;
+	// the node was modified when the placement started, refresh the caches once it arrives
+	if (PlacementAlpha >= 1.0f)
+	{
+		FAutoSizeCommentGraphHandler::Get().MarkNodeModified(GraphNode);
 	}
 }
 
@@ -1973,56 +2064,10 @@ void SAutoSizeCommentsGraphNode::CreateColorControls()
 ****** Util functions ******
 ****************************/
 
-TSet<TSharedPtr<SAutoSizeCommentsGraphNode>> SAutoSizeCommentsGraphNode::GetOtherCommentNodes()
-{
-	TSharedPtr<SGraphPanel> OwnerPanel = GetOwnerPanel();
-	if (!OwnerPanel || !OwnerPanel.IsValid())
-	{
-		return TSet<TSharedPtr<SAutoSizeCommentsGraphNode>>();
-	}
-
-	FChildren* PanelChildren = OwnerPanel->GetAllChildren();
-	int32 NumChildren = PanelChildren->Num();
-
-	// Get list of all other comment nodes
-	TSet<TSharedPtr<SAutoSizeCommentsGraphNode>> OtherCommentNodes;
-	for (int32 NodeIndex = 0; NodeIndex < NumChildren; ++NodeIndex)
-	{
-		TSharedPtr<SGraphNode> SomeNodeWidget = StaticCastSharedRef<SGraphNode>(PanelChildren->GetChildAt(NodeIndex));
-		TSharedPtr<SAutoSizeCommentsGraphNode> ASCGraphNode = StaticCastSharedPtr<SAutoSizeCommentsGraphNode>(SomeNodeWidget);
-		if (ASCGraphNode.IsValid())
-		{
-			UObject* GraphObject = SomeNodeWidget->GetObjectBeingDisplayed();
-			if (UEdGraphNode_Comment* GraphCommentNode = Cast<UEdGraphNode_Comment>(GraphObject))
-			{
-				if (GraphCommentNode != CommentNode)
-				{
-					OtherCommentNodes.Add(ASCGraphNode);
-				}
-			}
-		}
-	}
-
-	return OtherCommentNodes;
-}
-
 TArray<UEdGraphNode_Comment*> SAutoSizeCommentsGraphNode::GetParentComments() const
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SAutoSizeCommentsGraphNode::GetParentComments"), STAT_ASC_GetParentComments, STATGROUP_AutoSizeComments);
-	TArray<UEdGraphNode_Comment*> ParentComments;
-
-	for (UEdGraphNode* OtherNode : CommentNode->GetGraph()->Nodes)
-	{
-		if (auto OtherComment = Cast<UEdGraphNode_Comment>(OtherNode))
-		{
-			if (OtherComment != CommentNode && OtherComment->GetNodesUnderComment().Contains(CommentNode))
-			{
-				ParentComments.Add(OtherComment);
-			}
-		}
-	}
-
-	return ParentComments;
+	return FAutoSizeCommentGraphHandler::Get().GetCommentContainment(CommentNode->GetGraph()).GetContainingComments(CommentNode);
 }
 
 FSlateRect SAutoSizeCommentsGraphNode::GetCommentBounds(UEdGraphNode_Comment* InCommentNode)
@@ -2139,6 +2184,7 @@ void SAutoSizeCommentsGraphNode::SetIsHeader(bool bNewValue, bool bUpdateStyle)
 	// update the comment data
 	FASCCommentData& CommentData = GetCommentData();
 	CommentData.SetHeader(bNewValue);
+	FAutoSizeCommentsCacheFile::Get().MarkCommentDirty(CommentNode);
 
 	if (bIsHeader) // apply header style
 	{
@@ -2221,36 +2267,21 @@ bool SAutoSizeCommentsGraphNode::IsNodeUnrelated() const
 
 void SAutoSizeCommentsGraphNode::SetNodesRelated(const TArray<UEdGraphNode*>& Nodes, bool bIncludeSelf)
 {
-#if ASC_UE_VERSION_OR_LATER(4, 23)
-	const TArray<UEdGraphNode*>& AllNodes = GetNodeObj()->GetGraph()->Nodes;
-	for (UEdGraphNode* Node : AllNodes)
-	{
-		Node->SetNodeUnrelated(true);
-	}
-
 	if (bIncludeSelf)
 	{
-		GetCommentNodeObj()->SetNodeUnrelated(false);
+		TArray<UEdGraphNode*> RelatedNodes(Nodes);
+		RelatedNodes.Add(GetCommentNodeObj());
+		FAutoSizeCommentGraphHandler::Get().SetNodesRelated(GetNodeObj()->GetGraph(), RelatedNodes);
 	}
-
-	for (UEdGraphNode* Node : Nodes)
+	else
 	{
-		Node->SetNodeUnrelated(false);
+		FAutoSizeCommentGraphHandler::Get().SetNodesRelated(GetNodeObj()->GetGraph(), Nodes);
 	}
-#endif
 }
 
 void SAutoSizeCommentsGraphNode::ResetNodesUnrelated()
 {
-#if ASC_UE_VERSION_OR_LATER(4, 23)
-	if (UEdGraph* Graph = GetNodeObj()->GetGraph())
-	{
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			Node->SetNodeUnrelated(false);
-		}
-	}
-#endif
+	FAutoSizeCommentGraphHandler::Get().ResetNodesUnrelated(GetNodeObj()->GetGraph());
 }
 
 bool SAutoSizeCommentsGraphNode::IsExistingComment() const
@@ -2305,7 +2336,7 @@ bool SAutoSizeCommentsGraphNode::IsPresetStyle()
 
 bool SAutoSizeCommentsGraphNode::LoadCache()
 {
-	CommentNode->ClearNodesUnderComment();
+	FASCUtils::ClearCommentNodes(CommentNode, false);
 
 	TArray<UEdGraphNode*> OutNodesUnder;
 	if (FAutoSizeCommentsCacheFile::Get().GetNodesUnderComment(SharedThis(this), OutNodesUnder))
@@ -2326,7 +2357,7 @@ bool SAutoSizeCommentsGraphNode::LoadCache()
 
 void SAutoSizeCommentsGraphNode::UpdateCache()
 {
-	GetCommentData().UpdateNodesUnderComment(CommentNode);
+	FAutoSizeCommentsCacheFile::Get().UpdateNodesUnderComment(CommentNode);
 }
 
 void SAutoSizeCommentsGraphNode::QueryNodesUnderComment(TArray<UEdGraphNode*>& OutNodesUnderComment, const ECommentCollisionMethod OverrideCollisionMethod, const bool bIgnoreKnots)
@@ -2348,7 +2379,21 @@ void SAutoSizeCommentsGraphNode::QueryNodesUnderComment(TArray<TSharedPtr<SGraph
 
 	TSharedPtr<SGraphPanel> OwnerPanel = GetOwnerPanel();
 
-	float TitleBarHeight = GetTitleBarHeight();
+	TArray<TSharedPtr<SGraphNode>> OverlappingNodes;
+	FAutoSizeCommentGraphHandler::Get().GetSpatialIndex(OwnerPanel).QueryNodes(OwnerPanel, GetQueryBounds(), OverrideCollisionMethod, OverlappingNodes);
+
+	for (TSharedPtr<SGraphNode>& SomeNodeWidget : OverlappingNodes)
+	{
+		if (SomeNodeWidget->GetObjectBeingDisplayed() != CommentNode)
+		{
+			OutNodesUnderComment.Add(SomeNodeWidget);
+		}
+	}
+}
+
+FSlateRect SAutoSizeCommentsGraphNode::GetQueryBounds() const
+{
+	const float TitleBarHeight = GetTitleBarHeight();
 
 	const FASCVector2 NodeSize(UserSize.X, UserSize.Y - TitleBarHeight);
 
@@ -2356,48 +2401,134 @@ void SAutoSizeCommentsGraphNode::QueryNodesUnderComment(TArray<TSharedPtr<SGraph
 	FASCVector2 NodePosition = GetPos();
 	NodePosition.Y += TitleBarHeight;
 
-	const FSlateRect CommentRect = FSlateRect::FromPointAndExtent(NodePosition, NodeSize).ExtendBy(1);
+	return FSlateRect::FromPointAndExtent(NodePosition, NodeSize).ExtendBy(1);
+}
 
-	FChildren* PanelChildren = OwnerPanel->GetAllChildren();
-	int32 NumChildren = PanelChildren->Num();
+void SAutoSizeCommentsGraphNode::RequestRelatedNodesQuery(ECommentCollisionMethod CollisionMethod)
+{
+	PendingRelatedQuery = CollisionMethod;
+}
+
+void SAutoSizeCommentsGraphNode::UpdateRelatedNodesQuery(ECommentCollisionMethod CollisionMethod)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SAutoSizeCommentsGraphNode::UpdateRelatedNodesQuery"), STAT_ASC_UpdateRelatedNodesQuery, STATGROUP_AutoSizeComments);
 
-	// Iterate across all nodes in the graph
-	for (int32 NodeIndex = 0; NodeIndex < NumChildren; ++NodeIndex)
+	TSharedPtr<SGraphPanel> OwnerPanel = GetOwnerPanel();
+	if (!OwnerPanel)
 	{
-		const TSharedRef<SGraphNode> SomeNodeWidget = StaticCastSharedRef<SGraphNode>(PanelChildren->GetChildAt(NodeIndex));
+		return;
+	}
+
+	const FASCNodeHighlight& Highlight = FAutoSizeCommentGraphHandler::Get().GetGraphHandlerData(CommentNode->GetGraph()).NodeHighlight;
 
-		UObject* GraphObject = SomeNodeWidget->GetObjectBeingDisplayed();
-		if (GraphObject == nullptr || GraphObject == CommentNode)
+	// the highlight may have been reset or replaced since our last query
+	const FSlateRect NewBounds = GetQueryBounds();
+	const bool bCanUpdateIncrementally = bHasRelatedQuery &&
+		RelatedQueryMethod == CollisionMethod &&
+		CollisionMethod != ECommentCollisionMethod::Disabled &&
+		Highlight.IsActive() &&
+		Highlight.GetGeneration() == RelatedQueryHighlightGeneration;
+	if (bCanUpdateIncrementally && NewBounds == RelatedQueryBounds)
+	{
+		return;
+	}
+
+	const FSlateRect& OldBounds = RelatedQueryBounds;
+	const bool bLeftMoved = OldBounds.Left != NewBounds.Left;
+	const bool bRightMoved = OldBounds.Right != NewBounds.Right;
+	const bool bTopMoved = OldBounds.Top != NewBounds.Top;
+	const bool bBottomMoved = OldBounds.Bottom != NewBounds.Bottom;
+
+	// a node can only enter or leave the comment if it touches the area between the old and new edge
+	if (bCanUpdateIncrementally && (bLeftMoved + bRightMoved + bTopMoved + bBottomMoved) == 1)
+	{
+		FSlateRect SweptStrip = NewBounds;
+		if (bLeftMoved)
 		{
-			continue;
+			SweptStrip.Left = FMath::Min(OldBounds.Left, NewBounds.Left);
+			SweptStrip.Right = FMath::Max(OldBounds.Left, NewBounds.Left);
 		}
+		else if (bRightMoved)
+		{
+			SweptStrip.Left = FMath::Min(OldBounds.Right, NewBounds.Right);
+			SweptStrip.Right = FMath::Max(OldBounds.Right, NewBounds.Right);
+		}
+		else if (bTopMoved)
+		{
+			SweptStrip.Top = FMath::Min(OldBounds.Top, NewBounds.Top);
+			SweptStrip.Bottom = FMath::Max(OldBounds.Top, NewBounds.Top);
+		}
+		else
+		{
+			SweptStrip.Top = FMath::Min(OldBounds.Bottom, NewBounds.Bottom);
+			SweptStrip.Bottom = FMath::Max(OldBounds.Bottom, NewBounds.Bottom);
+		}
+
+		TArray<TSharedPtr<SGraphNode>> SweptNodes;
+		FAutoSizeCommentGraphHandler::Get().GetSpatialIndex(OwnerPanel).QueryNodes(OwnerPanel, SweptStrip.ExtendBy(1), ECommentCollisionMethod::Intersect, SweptNodes);
+
+		TArray<UEdGraphNode*> AddedNodes;
+		TArray<UEdGraphNode*> RemovedNodes;
+		for (TSharedPtr<SGraphNode>& SweptNode : SweptNodes)
+		{
+			UEdGraphNode* Node = SweptNode->GetNodeObj();
+			if (!Node || Node == CommentNode)
+			{
+				continue;
+			}
 
-		// check if the node bounds collides with our bounds
-		const FASCVector2 SomeNodePosition = FASCUtils::GetNodePos(&SomeNodeWidget.Get());
-		const FASCVector2 SomeNodeSize = SomeNodeWidget->GetDesiredSize();
-		const FSlateRect NodeGeometryGraphSpace = FSlateRect::FromPointAndExtent(SomeNodePosition, SomeNodeSize);
+			const bool bWasUnder = RelatedQueryNodes.Contains(Node);
+			const bool bIsUnder = FASCSpatialIndex::IsNodeColliding(*SweptNode, NewBounds, CollisionMethod);
+			if (bIsUnder && !bWasUnder)
+			{
+				RelatedQueryNodes.Add(Node);
+				AddedNodes.Add(Node);
+			}
+			else if (!bIsUnder && bWasUnder)
+			{
+				RelatedQueryNodes.Remove(Node);
+				RemovedNodes.Add(Node);
+			}
+		}
 
-		bool bIsOverlapping = false;
+		RelatedQueryBounds = NewBounds;
 
-		switch (OverrideCollisionMethod)
+		if (FAutoSizeCommentGraphHandler::Get().UpdateNodesRelated(CommentNode->GetGraph(), AddedNodes, RemovedNodes))
 		{
-			case ECommentCollisionMethod::Point:
-				bIsOverlapping = CommentRect.ContainsPoint(SomeNodePosition);
-				break;
-			case ECommentCollisionMethod::Intersect:
-				CommentRect.IntersectionWith(NodeGeometryGraphSpace, bIsOverlapping);
-				break;
-			case ECommentCollisionMethod::Contained:
-				bIsOverlapping = FSlateRect::IsRectangleContained(CommentRect, NodeGeometryGraphSpace);
-				break;
-			default: ;
+			return;
 		}
+	}
+	else
+	{
+		TArray<UEdGraphNode*> Nodes;
+		QueryNodesUnderComment(Nodes, CollisionMethod);
 
-		if (bIsOverlapping)
+		RelatedQueryNodes.Reset();
+		RelatedQueryNodes.Append(Nodes);
+		RelatedQueryBounds = NewBounds;
+		RelatedQueryMethod = CollisionMethod;
+		bHasRelatedQuery = true;
+	}
+
+	TArray<UEdGraphNode*> Nodes;
+	Nodes.Reserve(RelatedQueryNodes.Num());
+	for (const TWeakObjectPtr<UEdGraphNode>& Node : RelatedQueryNodes)
+	{
+		if (Node.IsValid())
 		{
-			OutNodesUnderComment.Add(SomeNodeWidget);
+			Nodes.Add(Node.Get());
 		}
 	}
+
+	SetNodesRelated(Nodes);
+	RelatedQueryHighlightGeneration = Highlight.GetGeneration();
+}
+
+void SAutoSizeCommentsGraphNode::ClearRelatedNodesQuery()
+{
+	PendingRelatedQuery.Reset();
+	RelatedQueryNodes.Reset();
+	bHasRelatedQuery = false;
 }
 
 void SAutoSizeCommentsGraphNode::RandomizeColor()
@@ -2483,16 +2614,6 @@ bool SAutoSizeCommentsGraphNode::CanAddNode(const UObject* Node, const bool bIgn
 	return CanAddNode(NodeAsGraphNode, bIgnoreKnots);
 }
 
-void SAutoSizeCommentsGraphNode::OnAltReleased()
-{
-	FAutoSizeCommentGraphHandler::Get().ProcessAltReleased(GetOwnerPanel());
-
-	if (!UAutoSizeCommentsSettings::Get().bHighlightContainingNodesOnSelection)
-	{
-		ResetNodesUnrelated();
-	}
-}
-
 bool SAutoSizeCommentsGraphNode::IsCommentNode(UObject* Object)
 {
 	return Object->IsA(UEdGraphNode_Comment::StaticClass());
@@ -2500,48 +2621,12 @@ bool SAutoSizeCommentsGraphNode::IsCommentNode(UObject* Object)
 
 FSlateRect SAutoSizeCommentsGraphNode::GetNodeBounds(UEdGraphNode* Node)
 {
-	if (!Node)
-	{
-		return FSlateRect();
-	}
-
-	FASCVector2 Pos(Node->NodePosX, Node->NodePosY);
-	FASCVector2 Size(300, 150);
-
-	TSharedPtr<SGraphNode> LocalGraphNode = FASCUtils::GetGraphNode(GetOwnerPanel(), Node);
-	if (LocalGraphNode.IsValid())
-	{
-		Pos = FASCUtils::GetNodePos(LocalGraphNode.Get());
-
-		// BlueprintAssist will write into NodeWidth and NodeHeight for non-resizable nodes
-		if (Node->bCanResizeNode || (UAutoSizeCommentsSettings::Get().bUseNodeSizeForBounds && FAutoSizeCommentsModule::IsBlueprintAssistEnabled() && Node->NodeWidth != 0 && Node->NodeHeight != 0))
-		{
-			Size.X = Node->NodeWidth;
-			Size.Y = Node->NodeHeight;
-		}
-		else
-		{
-			Size = LocalGraphNode->GetDesiredSize();
-		}
-
-		if (UAutoSizeCommentsSettings::Get().bUseCommentBubbleBounds && Node->bCommentBubbleVisible)
-		{
-			if (FNodeSlot* CommentSlot = LocalGraphNode->GetSlot(ENodeZone::TopCenter))
-			{
-				TSharedPtr<SCommentBubble> LocalCommentBubble = StaticCastSharedRef<SCommentBubble>(CommentSlot->GetWidget());
-
-				if (LocalCommentBubble.IsValid() && LocalCommentBubble->IsBubbleVisible())
-				{
-					FASCVector2 CommentBubbleSize = LocalCommentBubble->GetDesiredSize();
-					Pos.Y -= CommentBubbleSize.Y;
-					Size.Y += CommentBubbleSize.Y;
-					Size.X = FMath::Max(Size.X, CommentBubbleSize.X);
-				}
-			}
-		}
-	}
+	return FAutoSizeCommentGraphHandler::Get().GetNodeBounds(GetOwnerPanel(), Node);
+}
 
-	return FSlateRect::FromPointAndExtent(Pos, Size);
+bool SAutoSizeCommentsGraphNode::IsGeometryFromResize() const
+{
+	return bHasResizedGeometry && GetPos().Equals(ResizedPos, .1f) && UserSize.Equals(ResizedSize, .1f);
 }
 
 bool SAutoSizeCommentsGraphNode::AnySelectedNodes()
@@ -2552,16 +2637,35 @@ bool SAutoSizeCommentsGraphNode::AnySelectedNodes()
 
 FSlateRect SAutoSizeCommentsGraphNode::GetBoundsForNodesInside()
 {
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("SAutoSizeCommentsGraphNode::GetBoundsForNodesInside"), STAT_ASC_GetBoundsForNodesInside, STATGROUP_AutoSizeComments);
+
+	// reuse the bounds from the last resize if none of the nodes inside have changed
+	// only reactive mode scans the nodes for changes, so the other modes always recalculate
+	FASCBoundsCache& BoundsCache = FAutoSizeCommentGraphHandler::Get().GetGraphHandlerData(CommentNode->GetGraph()).BoundsCache;
+	const bool bUseBoundsCache = GetResizingMode() == EASCResizingMode::Reactive;
+	FSlateRect CachedBounds;
+	if (bUseBoundsCache && BoundsCache.FindCommentBounds(CommentNode, CachedBounds))
+	{
+		return CachedBounds;
+	}
+
+	// the depth of the comments can change without any notification, don't cache comments which contain each other
+	bool bCanCacheBounds = bUseBoundsCache;
+
 	TArray<UEdGraphNode*> Nodes;
 	for (UObject* Obj : CommentNode->GetNodesUnderComment())
 	{
 		if (UEdGraphNode_Comment* OtherCommentNode = Cast<UEdGraphNode_Comment>(Obj))
 		{
 			// if the node contains us and is higher depth, do not resize
-			if (OtherCommentNode->GetNodesUnderComment().Contains(GraphNode) &&
-				OtherCommentNode->CommentDepth > CommentNode->CommentDepth)
+			if (OtherCommentNode->GetNodesUnderComment().Contains(GraphNode))
 			{
-				continue;
+				bCanCacheBounds = false;
+
+				if (OtherCommentNode->CommentDepth > CommentNode->CommentDepth)
+				{
+					continue;
+				}
 			}
 		}
 
@@ -2594,6 +2698,11 @@ FSlateRect SAutoSizeCommentsGraphNode::GetBoundsForNodesInside()
 		}
 	}
 
+	if (bBoundsInit && bCanCacheBounds)
+	{
+		BoundsCache.SetCommentBounds(CommentNode, Bounds);
+	}
+
 	return Bounds;
 }
 
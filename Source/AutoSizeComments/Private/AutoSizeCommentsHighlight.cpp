@@ -0,0 +1,136 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "AutoSizeCommentsHighlight.h"
+
+#include "AutoSizeCommentsGraphNode.h"
+#include "AutoSizeCommentsMacros.h"
+#include "EdGraph/EdGraph.h"
+
+void FASCNodeHighlight::SetRelatedNodes(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes)
+{
+#if ASC_UE_VERSION_OR_LATER(4, 23)
+	if (!Graph)
+	{
+		return;
+	}
+
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCNodeHighlight::SetRelatedNodes"), STAT_ASC_NodeHighlight_SetRelatedNodes, STATGROUP_AutoSizeComments);
+
+	TSet<TWeakObjectPtr<UEdGraphNode>> NewRelatedNodes;
+	NewRelatedNodes.Reserve(Nodes.Num());
+	for (UEdGraphNode* Node : Nodes)
+	{
+		if (Node)
+		{
+			NewRelatedNodes.Add(Node);
+		}
+	}
+
+	if (!bActive || bRequiresFullUpdate)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node)
+			{
+				Node->SetNodeUnrelated(!NewRelatedNodes.Contains(Node));
+			}
+		}
+	}
+	else
+	{
+		for (const TWeakObjectPtr<UEdGraphNode>& Node : RelatedNodes)
+		{
+			if (Node.IsValid() && !NewRelatedNodes.Contains(Node))
+			{
+				Node->SetNodeUnrelated(true);
+			}
+		}
+
+		for (const TWeakObjectPtr<UEdGraphNode>& Node : NewRelatedNodes)
+		{
+			if (!RelatedNodes.Contains(Node))
+			{
+				Node->SetNodeUnrelated(false);
+			}
+		}
+	}
+
+	RelatedNodes = MoveTemp(NewRelatedNodes);
+	bRequiresFullUpdate = false;
+	bActive = true;
+	++Generation;
+#endif
+}
+
+bool FASCNodeHighlight::UpdateRelatedNodes(UEdGraph* Graph, const TArray<UEdGraphNode*>& AddedNodes, const TArray<UEdGraphNode*>& RemovedNodes)
+{
+#if ASC_UE_VERSION_OR_LATER(4, 23)
+	if (!Graph || !bActive || bRequiresFullUpdate)
+	{
+		return false;
+	}
+
+	for (UEdGraphNode* Node : RemovedNodes)
+	{
+		if (Node && RelatedNodes.Remove(Node) > 0)
+		{
+			Node->SetNodeUnrelated(true);
+		}
+	}
+
+	for (UEdGraphNode* Node : AddedNodes)
+	{
+		bool bAlreadyRelated = false;
+		if (Node)
+		{
+			RelatedNodes.Add(Node, &bAlreadyRelated);
+			if (!bAlreadyRelated)
+			{
+				Node->SetNodeUnrelated(false);
+			}
+		}
+	}
+#endif
+
+	return true;
+}
+
+void FASCNodeHighlight::Reset(UEdGraph* Graph)
+{
+#if ASC_UE_VERSION_OR_LATER(4, 23)
+	// clear every node even when inactive, the unrelated state can also be set outside of the highlight
+	bActive = false;
+	bRequiresFullUpdate = false;
+	RelatedNodes.Empty();
+	++Generation;
+
+	if (Graph)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node)
+			{
+				Node->SetNodeUnrelated(false);
+			}
+		}
+	}
+#endif
+}
+
+void FASCNodeHighlight::OnNodesAdded(const TSet<const UEdGraphNode*>& Nodes)
+{
+#if ASC_UE_VERSION_OR_LATER(4, 23)
+	if (!bActive)
+	{
+		return;
+	}
+
+	for (const UEdGraphNode* Node : Nodes)
+	{
+		if (Node && !RelatedNodes.Contains(Node))
+		{
+			const_cast<UEdGraphNode*>(Node)->SetNodeUnrelated(true);
+		}
+	}
+#endif
+}
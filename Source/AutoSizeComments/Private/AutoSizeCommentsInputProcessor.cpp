@@ -59,7 +59,7 @@ bool FAutoSizeCommentsInputProcessor::HandleMouseButtonDownEvent(FSlateApplicati
 					TSharedPtr<SGraphPanel> GraphPanel = StaticCastSharedPtr<SGraphPanel>(Widget);
 					if (GraphPanel.IsValid())
 					{
-						TSharedPtr<SGraphPin> HoveredPin = FASCUtils::GetHoveredGraphPin(GraphPanel);
+						TSharedPtr<SGraphPin> HoveredPin = FASCUtils::GetHoveredGraphPin(GraphPanel, WidgetPath);
 						if (HoveredPin.IsValid())
 						{
 							UEdGraphNode* OwningNode = HoveredPin->GetPinObj()->GetOwningNode();
@@ -2,181 +2,130 @@
 
 #include "AutoSizeCommentsNodeChangeData.h"
 
+#include "AutoSizeCommentsGraphNode.h"
 #include "AutoSizeCommentsModule.h"
 #include "AutoSizeCommentsUtils.h"
 #include "EdGraphNode_Comment.h"
 #include "EdGraphSchema_K2.h"
 #include "K2Node_CreateDelegate.h"
+#include "Hash/CityHash.h"
 
-void FASCPinChangeData::UpdatePin(UEdGraphPin* Pin)
+namespace ASCNodeFingerprint
 {
-	bPinHidden = Pin->bHidden;
-	bPinLinked = Pin->LinkedTo.Num() > 0;
-	PinValue = Pin->DefaultValue;
-	PinTextValue = Pin->DefaultTextValue;
-	PinLabel = GetPinLabel(Pin);
-	PinObject = GetPinDefaultObjectName(Pin);
-}
-
-bool FASCPinChangeData::HasPinChanged(UEdGraphPin* Pin)
-{
-	if (bPinHidden != Pin->bHidden)
-	{
-		return true;
-	}
-
-	if (bPinLinked != (Pin->LinkedTo.Num() > 0))
-	{
-		// these pins do not change size
-		if (Pin->PinType.PinSubCategory != UEdGraphSchema_K2::PC_Exec)
-		{
-			return true;
-		}
-	}
-
-	if (PinValue != Pin->DefaultValue)
-	{
-		return true;
-	}
-
-	if (!PinTextValue.EqualTo(Pin->DefaultTextValue, ETextComparisonLevel::Default))
+	template <typename T>
+	void Add(uint64& Hash, const T& Value)
 	{
-		return true;
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(&Value), sizeof(T), Hash);
 	}
 
-	if (!PinLabel.EqualTo(GetPinLabel(Pin), ETextComparisonLevel::Default))
+	void Add(uint64& Hash, const FString& Value)
 	{
-		return true;
+		Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*Value), Value.Len() * sizeof(TCHAR), Hash);
 	}
 
-	const FString PinDefaultObjectName = GetPinDefaultObjectName(Pin);
-	if (PinObject != PinDefaultObjectName)
+	void Add(uint64& Hash, const FName& Value)
 	{
-		return true;
+		Add(Hash, GetTypeHash(Value));
 	}
-
-
-	return false;
-}
-
-FString FASCPinChangeData::GetPinDefaultObjectName(UEdGraphPin* Pin) const
-{
-	return Pin->DefaultObject ? Pin->DefaultObject->GetName() : FString();
 }
 
-FText FASCPinChangeData::GetPinLabel(UEdGraphPin* Pin) const
+uint64 FASCNodeChangeData::GetFingerprint(UEdGraphNode* Node)
 {
-	if (Pin)
+	if (bDirty)
 	{
-		if (UEdGraphNode* GraphNode = Pin->GetOwningNodeUnchecked())
-		{
-			return GraphNode->GetPinDisplayName(Pin);
-		}
+		Fingerprint = ComputeFingerprint(Node);
+		bDirty = false;
 	}
 
-	return FText::GetEmpty();
+	return Fingerprint;
 }
 
-void FASCNodeChangeData::UpdateNode(UEdGraphNode* Node)
+uint64 FASCNodeChangeData::ComputeFingerprint(UEdGraphNode* Node)
 {
-	PinChangeData.Reset();
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCNodeChangeData::ComputeFingerprint"), STAT_ASC_NodeChangeData_ComputeFingerprint, STATGROUP_AutoSizeComments);
+
+	uint64 Hash = 0;
+
 	for (UEdGraphPin* Pin : Node->GetAllPins())
 	{
-		PinChangeData.FindOrAdd(Pin->PinId).UpdatePin(Pin);
+		HashPin(Hash, Pin);
 	}
 
-	AdvancedPinDisplay = Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown;
-	NodeTitle = Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString();
-	bCommentBubblePinned = Node->bCommentBubblePinned;
-	NodeEnabledState = Node->GetDesiredEnabledState();
-	NodeX = Node->NodePosX;
-	NodeY = Node->NodePosY;
+	ASCNodeFingerprint::Add(Hash, Node->NodePosX);
+	ASCNodeFingerprint::Add(Hash, Node->NodePosY);
+	ASCNodeFingerprint::Add(Hash, Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown);
+	ASCNodeFingerprint::Add(Hash, Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+	ASCNodeFingerprint::Add(Hash, static_cast<bool>(Node->bCommentBubblePinned));
+	ASCNodeFingerprint::Add(Hash, Node->GetDesiredEnabledState());
 
 	if (UK2Node_CreateDelegate* Delegate = Cast<UK2Node_CreateDelegate>(Node))
 	{
-		DelegateFunctionName = Delegate->GetFunctionName();
+		ASCNodeFingerprint::Add(Hash, Delegate->GetFunctionName());
 	}
+
+	return Hash;
 }
 
-bool FASCNodeChangeData::HasNodeChanged(UEdGraphNode* Node)
+void FASCNodeChangeData::HashPin(uint64& Hash, UEdGraphPin* Pin)
 {
-	if (Node->NodePosX != NodeX || Node->NodePosY != NodeY)
-	{
-		return true;
-	}
+	ASCNodeFingerprint::Add(Hash, Pin->PinId);
+	ASCNodeFingerprint::Add(Hash, static_cast<bool>(Pin->bHidden));
 
-	TArray<FGuid> PinGuids;
-	PinChangeData.GetKeys(PinGuids);
-
-	for (UEdGraphPin* Pin : Node->GetAllPins())
+	// these pins do not change size
+	if (Pin->PinType.PinSubCategory != UEdGraphSchema_K2::PC_Exec)
 	{
-		if (FASCPinChangeData* FoundPinData = PinChangeData.Find(Pin->PinId))
-		{
-			if (FoundPinData->HasPinChanged(Pin))
-			{
-				return true;
-			}
-
-			PinGuids.Remove(Pin->PinId);
-		}
-		else // added a new pin
-		{
-			return true;
-		}
+		ASCNodeFingerprint::Add(Hash, Pin->LinkedTo.Num() > 0);
 	}
 
-	// If there are remaining pins, then they must have been removed
-	if (PinGuids.Num())
-	{
-		return true;
-	}
+	ASCNodeFingerprint::Add(Hash, Pin->DefaultValue);
+	ASCNodeFingerprint::Add(Hash, Pin->DefaultTextValue.ToString());
+	ASCNodeFingerprint::Add(Hash, Pin->DefaultObject ? Pin->DefaultObject->GetName() : FString());
 
-	if (AdvancedPinDisplay != (Node->AdvancedPinDisplay == ENodeAdvancedPins::Shown))
+	if (UEdGraphNode* GraphNode = Pin->GetOwningNodeUnchecked())
 	{
-		return true;
-	}
-
-	if (NodeTitle != Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString())
-	{
-		return true;
+		ASCNodeFingerprint::Add(Hash, GraphNode->GetPinDisplayName(Pin).ToString());
 	}
+}
 
-	if (bCommentBubblePinned != Node->bCommentBubblePinned)
-	{
-		return true;
-	}
+uint64 FASCNodeChangeStore::GetFingerprint(UEdGraphNode* Node)
+{
+	return NodeChangeData.FindOrAdd(Node).GetFingerprint(Node);
+}
 
-	if (NodeEnabledState != Node->GetDesiredEnabledState())
+void FASCNodeChangeStore::MarkNodeDirty(UEdGraphNode* Node)
+{
+	if (FASCNodeChangeData* Data = NodeChangeData.Find(Node))
 	{
-		return true;
+		Data->MarkDirty();
 	}
+}
 
-	if (UK2Node_CreateDelegate* Delegate = Cast<UK2Node_CreateDelegate>(Node))
+void FASCNodeChangeStore::RemoveInvalidNodes()
+{
+	for (auto Iter = NodeChangeData.CreateIterator(); Iter; ++Iter)
 	{
-		if (DelegateFunctionName != Delegate->GetFunctionName())
+		if (!Iter.Key().IsValid())
 		{
-			return true;
+			Iter.RemoveCurrent();
 		}
 	}
-
-	return false;
 }
 
-void FASCCommentChangeData::UpdateComment(UEdGraphNode_Comment* Comment)
+void FASCCommentChangeData::UpdateComment(UEdGraphNode_Comment* Comment, FASCNodeChangeStore& NodeStore)
 {
-	NodeChangeData.Reset();
+	NodeFingerprints.Reset();
 	for (UObject* Obj : Comment->GetNodesUnderComment())
 	{
 		if (UEdGraphNode* Node = Cast<UEdGraphNode>(Obj))
 		{
-			NodeChangeData.FindOrAdd(Node).UpdateNode(Node);
+			NodeFingerprints.Add(Node, NodeStore.GetFingerprint(Node));
 		}
 	}
 
 	NodeComment = Comment->NodeComment;
 }
 
-bool FASCCommentChangeData::HasCommentChanged(UEdGraphNode_Comment* Comment)
+bool FASCCommentChangeData::HasCommentChanged(UEdGraphNode_Comment* Comment, FASCNodeChangeStore& NodeStore)
 {
 	if (!Comment)
 	{
@@ -195,7 +144,7 @@ bool FASCCommentChangeData::HasCommentChanged(UEdGraphNode_Comment* Comment)
 	}
 
 	TArray<TWeakObjectPtr<UEdGraphNode>> LastNodes;
-	NodeChangeData.GetKeys(LastNodes);
+	NodeFingerprints.GetKeys(LastNodes);
 
 	// remove all deleted / invalid nodes
 	for (int i = LastNodes.Num() - 1; i >= 0; --i)
@@ -228,8 +177,8 @@ bool FASCCommentChangeData::HasCommentChanged(UEdGraphNode_Comment* Comment)
 	{
 		if (Node.IsValid())
 		{
-			FASCNodeChangeData* Data = NodeChangeData.Find(Node);
-			if (Data && Data->HasNodeChanged(Node.Get()))
+			const uint64* Fingerprint = NodeFingerprints.Find(Node);
+			if (Fingerprint && *Fingerprint != NodeStore.GetFingerprint(Node.Get()))
 			{
 				// UE_LOG(LogTemp, Warning, TEXT("Data has changed!"));
 				return true;
@@ -243,7 +192,7 @@ bool FASCCommentChangeData::HasCommentChanged(UEdGraphNode_Comment* Comment)
 void FASCCommentChangeData::DebugPrint()
 {
 	UE_LOG(LogAutoSizeComments, Log, TEXT("%s"), *NodeComment);
-	for (auto& Elem : NodeChangeData)
+	for (auto& Elem : NodeFingerprints)
 	{
 		if (Elem.Key.IsValid())
 		{
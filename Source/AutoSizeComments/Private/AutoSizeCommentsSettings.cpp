@@ -55,6 +55,7 @@ UAutoSizeCommentsSettings::UAutoSizeCommentsSettings(const FObjectInitializer& O
 	bUseNodeSizeForBounds = true;
 	bUseCommentBubbleBounds = true;
 	bMoveEmptyCommentBoxes = false;
+	EmptyCommentBoxAnimationTime = 0.15f;
 	EmptyCommentBoxSpeed = 10;
 	bHideCommentBubble = false;
 	bEnableCommentBubbleDefaults = false;
@@ -62,8 +63,11 @@ UAutoSizeCommentsSettings::UAutoSizeCommentsSettings(const FObjectInitializer& O
 	bDefaultShowBubbleWhenZoomed = true;
 	CacheSaveMethod = EASCCacheSaveMethod::MetaData;
 	CacheSaveLocation = EASCCacheSaveLocation::Project;
+	CacheFileFormat = EASCCacheFileFormat::Json;
 	bSaveCommentDataOnSavingGraph = true;
 	bSaveCommentDataOnExit = false;
+	bWriteCacheJournal = false;
+	CacheJournalCompactionSize = 64;
 	bPrettyPrintCommentCacheJSON = false;
 	bApplyColorToExistingNodes = false;
 	bResizeExistingNodes = false;
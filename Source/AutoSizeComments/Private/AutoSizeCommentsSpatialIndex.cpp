@@ -0,0 +1,217 @@
+// Copyright fpwong. All Rights Reserved.
+
+#include "AutoSizeCommentsSpatialIndex.h"
+
+#include "AutoSizeCommentsGraphNode.h"
+#include "AutoSizeCommentsSettings.h"
+#include "AutoSizeCommentsUtils.h"
+#include "SGraphPanel.h"
+
+void FASCSpatialIndex::QueryNodes(TSharedPtr<SGraphPanel> GraphPanel, const FSlateRect& Bounds, ECommentCollisionMethod CollisionMethod, TArray<TSharedPtr<SGraphNode>>& OutNodes)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCSpatialIndex::QueryNodes"), STAT_ASC_SpatialIndex_QueryNodes, STATGROUP_AutoSizeComments);
+
+	if (!GraphPanel || CollisionMethod == ECommentCollisionMethod::Disabled)
+	{
+		return;
+	}
+
+	if (bRequiresRebuild || Entries.Num() != GraphPanel->GetAllChildren()->Num())
+	{
+		Rebuild(GraphPanel);
+	}
+	else if (GFrameCounter - LastGeometrySyncFrame > 1)
+	{
+		UpdateAllNodes();
+	}
+	else
+	{
+		UpdateDirtyNodes();
+	}
+
+	// gather the entries from the overlapping cells
+	TSet<int32> Candidates;
+	const FIntRect QueryCells = GetCellsForBounds(Bounds);
+	for (int32 X = QueryCells.Min.X; X <= QueryCells.Max.X; ++X)
+	{
+		for (int32 Y = QueryCells.Min.Y; Y <= QueryCells.Max.Y; ++Y)
+		{
+			if (const TArray<int32>* Cell = Grid.Find(FIntPoint(X, Y)))
+			{
+				Candidates.Append(*Cell);
+			}
+		}
+	}
+
+	// keep the panel order of the nodes
+	TArray<int32> SortedCandidates = Candidates.Array();
+	SortedCandidates.Sort();
+
+	for (int32 EntryIndex : SortedCandidates)
+	{
+		TSharedPtr<SGraphNode> NodeWidget = Entries[EntryIndex].Widget.Pin();
+		if (!NodeWidget || !NodeWidget->GetObjectBeingDisplayed())
+		{
+			continue;
+		}
+
+		if (IsNodeColliding(*NodeWidget, Bounds, CollisionMethod))
+		{
+			OutNodes.Add(NodeWidget);
+		}
+	}
+}
+
+bool FASCSpatialIndex::IsNodeColliding(const SGraphNode& NodeWidget, const FSlateRect& Bounds, ECommentCollisionMethod CollisionMethod)
+{
+	bool bIsOverlapping = false;
+
+	switch (CollisionMethod)
+	{
+		case ECommentCollisionMethod::Point:
+			bIsOverlapping = Bounds.ContainsPoint(FASCUtils::GetNodePos(&NodeWidget));
+			break;
+		case ECommentCollisionMethod::Intersect:
+			Bounds.IntersectionWith(GetNodeBounds(NodeWidget), bIsOverlapping);
+			break;
+		case ECommentCollisionMethod::Contained:
+			bIsOverlapping = FSlateRect::IsRectangleContained(Bounds, GetNodeBounds(NodeWidget));
+			break;
+		default: ;
+	}
+
+	return bIsOverlapping;
+}
+
+void FASCSpatialIndex::MarkNodeDirty(UEdGraphNode* Node)
+{
+	if (!bRequiresRebuild)
+	{
+		DirtyNodes.Add(Node);
+	}
+}
+
+void FASCSpatialIndex::Rebuild(TSharedPtr<SGraphPanel> GraphPanel)
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCSpatialIndex::Rebuild"), STAT_ASC_SpatialIndex_Rebuild, STATGROUP_AutoSizeComments);
+
+	Entries.Reset();
+	NodeToEntry.Reset();
+	Grid.Reset();
+	DirtyNodes.Reset();
+	bRequiresRebuild = false;
+	LastGeometrySyncFrame = GFrameCounter;
+
+	FChildren* PanelChildren = GraphPanel->GetAllChildren();
+	const int32 NumChildren = PanelChildren->Num();
+	Entries.Reserve(NumChildren);
+
+	for (int32 NodeIndex = 0; NodeIndex < NumChildren; ++NodeIndex)
+	{
+		const TSharedRef<SGraphNode> NodeWidget = StaticCastSharedRef<SGraphNode>(PanelChildren->GetChildAt(NodeIndex));
+
+		const int32 EntryIndex = Entries.Add(FEntry{ NodeWidget, GetCellsForBounds(GetNodeBounds(NodeWidget.Get())) });
+		if (UEdGraphNode* Node = NodeWidget->GetNodeObj())
+		{
+			NodeToEntry.Add(Node, EntryIndex);
+		}
+
+		AddToGrid(EntryIndex);
+	}
+}
+
+void FASCSpatialIndex::UpdateDirtyNodes()
+{
+	for (const TWeakObjectPtr<UEdGraphNode>& Node : DirtyNodes)
+	{
+		const int32* EntryIndex = NodeToEntry.Find(Node);
+		if (!EntryIndex)
+		{
+			continue;
+		}
+
+		FEntry& Entry = Entries[*EntryIndex];
+		TSharedPtr<SGraphNode> NodeWidget = Entry.Widget.Pin();
+		if (!NodeWidget)
+		{
+			continue;
+		}
+
+		const FIntRect NewCells = GetCellsForBounds(GetNodeBounds(*NodeWidget));
+		if (NewCells != Entry.Cells)
+		{
+			RemoveFromGrid(*EntryIndex);
+			Entry.Cells = NewCells;
+			AddToGrid(*EntryIndex);
+		}
+	}
+
+	DirtyNodes.Reset();
+}
+
+void FASCSpatialIndex::UpdateAllNodes()
+{
+	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCSpatialIndex::UpdateAllNodes"), STAT_ASC_SpatialIndex_UpdateAllNodes, STATGROUP_AutoSizeComments);
+
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+	{
+		FEntry& Entry = Entries[EntryIndex];
+		TSharedPtr<SGraphNode> NodeWidget = Entry.Widget.Pin();
+		if (!NodeWidget)
+		{
+			continue;
+		}
+
+		const FIntRect NewCells = GetCellsForBounds(GetNodeBounds(*NodeWidget));
+		if (NewCells != Entry.Cells)
+		{
+			RemoveFromGrid(EntryIndex);
+			Entry.Cells = NewCells;
+			AddToGrid(EntryIndex);
+		}
+	}
+
+	DirtyNodes.Reset();
+	LastGeometrySyncFrame = GFrameCounter;
+}
+
+void FASCSpatialIndex::AddToGrid(int32 EntryIndex)
+{
+	const FIntRect& Cells = Entries[EntryIndex].Cells;
+	for (int32 X = Cells.Min.X; X <= Cells.Max.X; ++X)
+	{
+		for (int32 Y = Cells.Min.Y; Y <= Cells.Max.Y; ++Y)
+		{
+			Grid.FindOrAdd(FIntPoint(X, Y)).Add(EntryIndex);
+		}
+	}
+}
+
+void FASCSpatialIndex::RemoveFromGrid(int32 EntryIndex)
+{
+	const FIntRect& Cells = Entries[EntryIndex].Cells;
+	for (int32 X = Cells.Min.X; X <= Cells.Max.X; ++X)
+	{
+		for (int32 Y = Cells.Min.Y; Y <= Cells.Max.Y; ++Y)
+		{
+			if (TArray<int32>* Cell = Grid.Find(FIntPoint(X, Y)))
+			{
+				Cell->RemoveSingleSwap(EntryIndex);
+			}
+		}
+	}
+}
+
+FSlateRect FASCSpatialIndex::GetNodeBounds(const SGraphNode& NodeWidget)
+{
+	return FSlateRect::FromPointAndExtent(FASCUtils::GetNodePos(&NodeWidget), NodeWidget.GetDesiredSize());
+}
+
+FIntRect FASCSpatialIndex::GetCellsForBounds(const FSlateRect& Bounds)
+{
+	return FIntRect(
+		FMath::FloorToInt(Bounds.Left / CellSize),
+		FMath::FloorToInt(Bounds.Top / CellSize),
+		FMath::FloorToInt(Bounds.Right / CellSize),
+		FMath::FloorToInt(Bounds.Bottom / CellSize));
+}
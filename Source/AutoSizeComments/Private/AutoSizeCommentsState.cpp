@@ -2,6 +2,7 @@
 
 #include "AutoSizeCommentsGraphNode.h"
 #include "EdGraphNode_Comment.h"
+#include "SGraphPanel.h"
 #include "Misc/LazySingleton.h"
 
 FASCState& FASCState::Get()
@@ -45,3 +46,64 @@ bool FASCState::HasRegisteredComment(UEdGraphNode_Comment* Comment)
 {
 	return CommentToASCMapping.Contains(Comment->NodeGuid);
 }
+
+void FASCState::AddPanelComment(TSharedPtr<SGraphPanel> Panel, TSharedRef<SAutoSizeCommentsGraphNode> ASCComment)
+{
+	if (!Panel)
+	{
+		return;
+	}
+
+	RemoveInvalidPanels();
+
+	// a visual refresh of the panel creates a new widget for the comment, which replaces the old one
+	const UEdGraphNode_Comment* Comment = ASCComment->GetCommentNodeObj();
+	TArray<TWeakPtr<SAutoSizeCommentsGraphNode>>& Comments = PanelComments.FindOrAdd(Panel);
+	Comments.RemoveAll([Comment](const TWeakPtr<SAutoSizeCommentsGraphNode>& Other)
+	{
+		TSharedPtr<SAutoSizeCommentsGraphNode> OtherComment = Other.Pin();
+		return !OtherComment || OtherComment->GetCommentNodeObj() == Comment;
+	});
+
+	Comments.Add(ASCComment);
+}
+
+void FASCState::RemovePanelComment(TSharedPtr<SGraphPanel> Panel, const SAutoSizeCommentsGraphNode* ASCComment)
+{
+	// a widget being destroyed can no longer be pinned, so expired entries are removed along with it
+	if (TArray<TWeakPtr<SAutoSizeCommentsGraphNode>>* Comments = Panel ? PanelComments.Find(Panel) : nullptr)
+	{
+		Comments->RemoveAll([ASCComment](const TWeakPtr<SAutoSizeCommentsGraphNode>& Comment)
+		{
+			return !Comment.IsValid() || Comment.Pin().Get() == ASCComment;
+		});
+
+		if (Comments->Num() == 0)
+		{
+			PanelComments.Remove(Panel);
+		}
+	}
+
+	RemoveInvalidPanels();
+}
+
+TConstArrayView<TWeakPtr<SAutoSizeCommentsGraphNode>> FASCState::GetPanelComments(TSharedPtr<SGraphPanel> Panel) const
+{
+	if (const TArray<TWeakPtr<SAutoSizeCommentsGraphNode>>* Comments = Panel ? PanelComments.Find(Panel) : nullptr)
+	{
+		return *Comments;
+	}
+
+	return TConstArrayView<TWeakPtr<SAutoSizeCommentsGraphNode>>();
+}
+
+void FASCState::RemoveInvalidPanels()
+{
+	for (auto Iter = PanelComments.CreateIterator(); Iter; ++Iter)
+	{
+		if (!Iter.Key().IsValid())
+		{
+			Iter.RemoveCurrent();
+		}
+	}
+}
@@ -1,10 +1,13 @@
 #include "AutoSizeCommentsUtils.h"
 
 #include "AutoSizeCommentsCacheFile.h"
+#include "AutoSizeCommentsGraphHandler.h"
 #include "AutoSizeCommentsGraphNode.h"
 #include "EdGraphNode_Comment.h"
 #include "SGraphPanel.h"
+#include "SGraphPin.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "Layout/WidgetPath.h"
 
 TArray<UEdGraphNode_Comment*> FASCUtils::GetContainingCommentNodes(const TArray<UEdGraphNode_Comment*>& Comments, UEdGraphNode* Node)
 {
@@ -21,6 +24,16 @@ TArray<UEdGraphNode_Comment*> FASCUtils::GetContainingCommentNodes(const TArray<
 	return ContainingComments;
 }
 
+TArray<UEdGraphNode_Comment*> FASCUtils::GetContainingCommentNodes(UEdGraphNode* Node)
+{
+	if (!Node || !Node->GetGraph())
+	{
+		return TArray<UEdGraphNode_Comment*>();
+	}
+
+	return FAutoSizeCommentGraphHandler::Get().GetCommentContainment(Node->GetGraph()).GetContainingComments(Node);
+}
+
 TArray<UEdGraphNode*> FASCUtils::GetNodesUnderComment(UEdGraphNode_Comment* Comment)
 {
 	TArray<UEdGraphNode*> OutNodes;
@@ -186,6 +199,55 @@ TSharedPtr<SGraphPin> FASCUtils::GetHoveredGraphPin(TSharedPtr<SGraphPanel> Grap
 	return nullptr;
 }
 
+TSharedPtr<SGraphPin> FASCUtils::GetHoveredGraphPin(TSharedPtr<SGraphPanel> GraphPanel, const FWidgetPath& WidgetPath)
+{
+	if (!GraphPanel.IsValid() || !GraphPanel->GetGraphObj())
+	{
+		return nullptr;
+	}
+
+	int32 PanelIndex = INDEX_NONE;
+	for (int32 i = WidgetPath.Widgets.Num() - 1; i >= 0; --i)
+	{
+		if (&WidgetPath.Widgets[i].Widget.Get() == GraphPanel.Get())
+		{
+			PanelIndex = i;
+			break;
+		}
+	}
+
+	// the node widgets are the direct children of the graph panel
+	const int32 NodeIndex = PanelIndex + 1;
+	if (PanelIndex == INDEX_NONE || !WidgetPath.Widgets.IsValidIndex(NodeIndex))
+	{
+		return nullptr;
+	}
+
+	TSharedRef<SGraphNode> NodeWidget = StaticCastSharedRef<SGraphNode>(WidgetPath.Widgets[NodeIndex].Widget);
+
+	TSet<TSharedRef<SWidget>> NodePins;
+	NodeWidget->GetPins(NodePins);
+	if (NodePins.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	// see GetHoveredGraphPin, material graphs only count a pin as hovered when it is the widget directly under the cursor
+	const bool bIsMaterialGraph = GraphPanel->GetGraphObj()->GetClass()->GetFName() == "MaterialGraph";
+	const int32 FirstIndex = bIsMaterialGraph ? WidgetPath.Widgets.Num() - 1 : NodeIndex + 1;
+
+	for (int32 i = WidgetPath.Widgets.Num() - 1; i >= FirstIndex; --i)
+	{
+		const TSharedRef<SWidget>& Widget = WidgetPath.Widgets[i].Widget;
+		if (NodePins.Contains(Widget))
+		{
+			return StaticCastSharedRef<SGraphPin>(Widget);
+		}
+	}
+
+	return nullptr;
+}
+
 TArray<UEdGraphNode_Comment*> FASCUtils::GetSelectedComments(TSharedPtr<SGraphPanel> GraphPanel)
 {
 	TArray<UEdGraphNode_Comment*> OutComments;
@@ -335,40 +397,12 @@ TSharedPtr<SWidget> FASCUtils::GetParentWidgetOfTypes(TSharedPtr<SWidget> Widget
 bool FASCUtils::DoesCommentContainComment(UEdGraphNode_Comment* Source, UEdGraphNode_Comment* Other)
 {
 	DECLARE_SCOPE_CYCLE_COUNTER(TEXT("FASCUtils::DoesCommentContainComment"), STAT_ASC_DoesCommentContainComment, STATGROUP_AutoSizeComments);
-	struct FLocal
+	if (!Source || !Other || !Source->GetGraph())
 	{
-		static bool DoesCommentContainComment_Recursive(UEdGraphNode_Comment* Source, UEdGraphNode_Comment* Other, TSet<UEdGraphNode*>& Visited)
-		{
-			if (Visited.Contains(Source))
-			{
-				return false;
-			}
-
-			Visited.Add(Source);
-
-
-			for (UObject* Node : Source->GetNodesUnderComment())
-			{
-				if (Node == Other)
-				{
-					return true;
-				}
-
-				if (UEdGraphNode_Comment* NextComment = Cast<UEdGraphNode_Comment>(Node))
-				{
-					if (DoesCommentContainComment_Recursive(NextComment, Other, Visited))
-					{
-						return true;
-					}
-				}
-			}
-
-			return false;
-		}
-	};
+		return false;
+	}
 
-	TSet<UEdGraphNode*> Visited;
-	return FLocal::DoesCommentContainComment_Recursive(Source, Other, Visited);
+	return FAutoSizeCommentGraphHandler::Get().GetCommentContainment(Source->GetGraph()).IsAncestorOf(Source, Other);
 }
 
 void FASCUtils::ClearCommentNodes(UEdGraphNode_Comment* Comment, bool bUpdateCache)
@@ -379,7 +413,13 @@ void FASCUtils::ClearCommentNodes(UEdGraphNode_Comment* Comment, bool bUpdateCac
 		return;
 	}
 
+	if (FASCCommentContainment* Containment = FAutoSizeCommentGraphHandler::Get().FindCommentContainment(Comment->GetGraph()))
+	{
+		Containment->OnCommentCleared(Comment);
+	}
+
 	Comment->ClearNodesUnderComment();
+	FAutoSizeCommentGraphHandler::Get().MarkNodeModified(Comment);
 
 	if (bUpdateCache)
 	{
@@ -414,7 +454,7 @@ bool FASCUtils::RemoveNodesFromComment(UEdGraphNode_Comment* Comment, const TSet
 	}
 
 	// Clear all nodes under comment
-	Comment->ClearNodesUnderComment();
+	ClearCommentNodes(Comment, false);
 
 	// Add back the nodes under comment while filtering out any which are to be removed
 	for (UObject* NodeUnderComment : NodesUnderComment)
@@ -460,6 +500,12 @@ bool FASCUtils::AddNodeIntoComment(UEdGraphNode_Comment* Comment, UObject* NewNo
 	}
 
 	Comment->AddNodeUnderComment(NewNode);
+	FAutoSizeCommentGraphHandler::Get().MarkNodeModified(Comment);
+
+	if (FASCCommentContainment* Containment = FAutoSizeCommentGraphHandler::Get().FindCommentContainment(Comment->GetGraph()))
+	{
+		Containment->OnNodeAdded(Comment, NewNode);
+	}
 
 	if (bUpdateCache)
 	{
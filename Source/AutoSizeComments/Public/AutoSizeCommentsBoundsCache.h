@@ -0,0 +1,47 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FASCCommentContainment;
+class SGraphNode;
+class SGraphPanel;
+class UEdGraphNode;
+class UEdGraphNode_Comment;
+
+/**
+ * Bounds of the nodes on a graph, refreshed from the node widget when the node moves or resizes.
+ * Also caches the combined bounds of the nodes inside each comment, which are grown in place when a member moves
+ * away from the edges and only recalculated when a member on the edge changes.
+ */
+struct FASCBoundsCache
+{
+	/** Cached bounds of the node, calculated from its widget if the node has not been cached yet */
+	FSlateRect GetNodeBounds(TSharedPtr<SGraphPanel> GraphPanel, UEdGraphNode* Node);
+
+	/** Recalculate the node's bounds from its widget and update the comments containing it */
+	void UpdateNodeBounds(SGraphNode& NodeWidget, const FASCCommentContainment& Containment);
+
+	/** The node was modified, its bounds are refreshed on the next update */
+	void MarkNodeDirty(UEdGraphNode* Node) { DirtyNodes.Add(Node); }
+	bool IsNodeDirty(UEdGraphNode* Node) const { return DirtyNodes.Contains(Node); }
+
+	bool FindCommentBounds(UEdGraphNode_Comment* Comment, FSlateRect& OutBounds) const;
+	void SetCommentBounds(UEdGraphNode_Comment* Comment, const FSlateRect& Bounds) { CommentBounds.Add(Comment, Bounds); }
+
+	/** The nodes inside the comment have changed */
+	void InvalidateComment(UEdGraphNode_Comment* Comment) { CommentBounds.Remove(Comment); }
+	void InvalidateComments() { CommentBounds.Reset(); }
+
+	void RemoveInvalidNodes();
+
+	static FSlateRect CalculateNodeBounds(SGraphNode& NodeWidget);
+
+private:
+	TMap<TWeakObjectPtr<UEdGraphNode>, FSlateRect> NodeBounds;
+	TMap<TWeakObjectPtr<UEdGraphNode_Comment>, FSlateRect> CommentBounds;
+	TSet<TWeakObjectPtr<UEdGraphNode>> DirtyNodes;
+
+	static bool IsInsideEdges(const FSlateRect& Inner, const FSlateRect& Outer);
+};
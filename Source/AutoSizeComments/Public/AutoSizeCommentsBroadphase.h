@@ -0,0 +1,54 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AutoSizeCommentsMacros.h"
+
+class UEdGraph;
+class UEdGraphNode_Comment;
+
+/**
+ * Bounds of the (non-header) comments on a graph sorted by their left edge, rebuilt at most once per frame.
+ * Overlap queries binary search for the first comment which can reach the query and sweep until the query's right edge.
+ */
+struct FASCCommentBroadphase
+{
+	/** Rebuild from the comments on the graph if it hasn't been built this frame */
+	void Update(UEdGraph* Graph);
+
+	/** The comments on the graph have changed, rebuild on the next update */
+	void Invalidate()
+	{
+		Entries.Reset();
+		MaxWidth = 0.0f;
+		LastBuildFrame = MAX_uint64;
+	}
+
+	/**
+	 * Find the nearest offset which moves the bounds clear of every other comment.
+	 * Candidates are made by pushing the bounds past the edges of the comments they overlap, so the result is deterministic.
+	 */
+	bool FindFreeOffset(const FSlateRect& Bounds, const UEdGraphNode_Comment* IgnoreComment, FASCVector2& OutOffset) const;
+
+	/** Re-sort the comment after it has been moved */
+	void UpdateComment(UEdGraphNode_Comment* Comment, const FSlateRect& NewBounds);
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UEdGraphNode_Comment> Comment;
+		FSlateRect Bounds;
+	};
+
+	TArray<FEntry> Entries;
+
+	/** Widest comment, used to find the first entry which can overlap a query */
+	float MaxWidth = 0.0f;
+
+	uint64 LastBuildFrame = MAX_uint64;
+
+	void AddSorted(FEntry&& Entry);
+
+	void QueryOverlapEntries(const FSlateRect& Bounds, const UEdGraphNode_Comment* IgnoreComment, TArray<int32>& OutEntryIndices) const;
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "SGraphPin.h"
+#include "Async/Future.h"
 #include "AutoSizeCommentsCacheFile.generated.h"
 
 class UEdGraphNode_Comment;
@@ -96,11 +97,27 @@ public:
 
 	void SaveCacheToFile();
 
+	/** Queue the graph's package to be written with SaveQueuedPackages (when the graph is saved) */
+	void QueuePackageSave(UEdGraph* Graph);
+	void SaveQueuedPackages();
+
+	/** Block until the cache files from the last save have been written */
+	void WaitForPendingSave();
+
 	void DeleteCache();
 
 	void CleanupFiles();
 
-	void UpdateNodesUnderComment(UEdGraphNode_Comment* Comment) { GetCommentData(Comment).UpdateNodesUnderComment(Comment); }
+	void UpdateNodesUnderComment(UEdGraphNode_Comment* Comment);
+
+	/** Record the comment so its latest data is appended to the package's journal on the next flush */
+	void MarkCommentDirty(UEdGraphNode_Comment* Comment);
+
+	/** Record the graph so all of its data replaces the journaled data on the next flush */
+	void MarkGraphDirty(UEdGraph* Graph);
+
+	/** Append the dirty comments to their package's journal and compact any large journals, called once per frame */
+	void FlushJournal();
 
 	FASCCommentData& GetCommentData(UEdGraphNode_Comment* Comment);
 	FASCGraphData& GetGraphData(UEdGraph* Graph);
@@ -113,6 +130,12 @@ public:
 	FString GetPluginCachePath(bool bFullPath = false);
 	FString GetCachePath(bool bFullPath = false);
 	FString GetAlternateCachePath(bool bFullPath = false);
+	FString GetCacheFileExtension();
+
+	/** Each package is cached in its own file in this directory */
+	FString GetPackageCacheDirectory();
+	FString GetPackageCachePath(FName PackageName);
+	static FName GetPackageNameFromCachePath(const FString& Path);
 
 	bool GetNodesUnderComment(TSharedPtr<SAutoSizeCommentsGraphNode> ASCNode, TArray<UEdGraphNode*>& OutNodesUnderComment);
 
@@ -125,9 +148,63 @@ public:
 protected:
 	FASCGraphData& GetCacheFileGraphData(UEdGraph* Graph);
 
+	bool ReadCacheFile(FASCCacheData& OutCacheData);
+
+	/** Map the package cache files in the package cache directory to their package name */
+	bool FindPackageCacheFiles(TMap<FName, FString>& OutPackageFiles);
+
+	/** Get the package data, reading its cache file if it hasn't been loaded yet */
+	FASCPackageData& FindOrLoadPackageData(FName PackageName);
+
+	void SavePackagesToFile(const TSet<FName>& PackageNames);
+	static void WritePackageCacheFile(const FString& Path, FASCCacheData& PackageCacheData, bool bPrettyPrintJson);
+
+	/** Delete the json and binary versions of the cache file and its journal */
+	static void DeleteCacheFile(const FString& Path);
+
+	void SaveCacheOnExit();
+
+	/** Json or binary depending on the file extension */
+	static bool LoadCacheDataFromPath(const FString& Path, FASCCacheData& OutCacheData);
+	static bool SaveCacheDataToPath(const FString& Path, FASCCacheData& InCacheData, bool bPrettyPrintJson);
+
+	/** Binary layout: magic, version, package name table then the graph data for each package (raw guids) */
+	static bool SerializeBinaryCache(FArchive& Ar, FASCCacheData& Data);
+	static void SerializeBinaryGraphData(FArchive& Ar, FASCGraphData& GraphData);
+	static void SerializeBinaryCommentData(FArchive& Ar, FASCCommentData& CommentData);
+
+	/** The journal sits next to the package cache file */
+	static FString GetJournalPath(const FString& PackageCachePath);
+
+	/** Apply the journaled changes on top of the package data, false if there is no journal */
+	static bool ReplayJournal(const FString& Path, FASCPackageData& PackageData);
+
+	/** Append the journal records for the dirty comments of the package, returns the size of the journal */
+	int64 WriteJournal(FName PackageName, const TMap<FGuid, TSet<FGuid>>& DirtyGraphs);
+
 	bool bHasLoaded = false;
 
+	/** Loaded from the old single cache file, write every package on the next save */
+	bool bRequiresPackageCacheMigration = false;
+
 	FASCCacheData CacheData;
 
+	/** Package cache files which have not been read yet (package -> file path) */
+	TMap<FName, FString> UnloadedPackageFiles;
+
+	/** Packages which have been opened this session */
+	TSet<FName> TouchedPackages;
+
+	TSet<FName> QueuedPackageSaves;
+
+	/** Comments changed since the last journal flush (package -> graph -> comments), an invalid comment guid rewrites the whole graph */
+	TMap<FName, TMap<FGuid, TSet<FGuid>>> DirtyJournalComments;
+
+	/** Packages whose journal should be folded into their cache file */
+	TSet<FName> PackagesRequiringCompaction;
+
+	/** Package files are serialized and written on a worker thread */
+	TFuture<void> PendingSave;
+
 	void OnPreExit();
 };
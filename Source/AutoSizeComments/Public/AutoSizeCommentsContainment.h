@@ -0,0 +1,44 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+class UEdGraphNode_Comment;
+
+/**
+ * Which comments contain each node on a graph, for a comment node these are its parent comments.
+ * Kept in sync by the FASCUtils comment helpers, rebuilt from the comment nodes when invalidated (undo, graph changes).
+ */
+struct FASCCommentContainment
+{
+	void Rebuild(UEdGraph* Graph);
+
+	void Invalidate() { bRequiresRebuild = true; }
+	bool RequiresRebuild() const { return bRequiresRebuild; }
+
+	void OnNodeAdded(UEdGraphNode_Comment* Comment, UObject* Node);
+	void OnCommentCleared(UEdGraphNode_Comment* Comment);
+
+	/** Comments which directly contain the node (for a comment node these are its parent comments) */
+	TArray<UEdGraphNode_Comment*> GetContainingComments(UObject* Node) const;
+
+	bool IsContained(UObject* Node) const;
+
+	/** Walk up the parents of the comment, true if the ancestor contains the comment directly or through a nested comment */
+	bool IsAncestorOf(UEdGraphNode_Comment* Ancestor, UEdGraphNode_Comment* Comment) const;
+
+	/** Number of comments the comment is nested in (0 for a top level comment) */
+	int32 GetNestingDepth(UEdGraphNode_Comment* Comment) const;
+
+private:
+	TMap<TWeakObjectPtr<UObject>, TArray<TWeakObjectPtr<UEdGraphNode_Comment>>> NodeToComments;
+
+	/** Cached for GetNestingDepth, cleared when the hierarchy changes */
+	mutable TMap<TWeakObjectPtr<UEdGraphNode_Comment>, int32> NestingDepths;
+
+	bool bRequiresRebuild = true;
+
+	static TArray<UEdGraphNode_Comment*> ToCommentArray(const TArray<TWeakObjectPtr<UEdGraphNode_Comment>>* WeakComments);
+};
@@ -2,13 +2,51 @@
 
 #pragma once
 
+#include "AutoSizeCommentsBoundsCache.h"
+#include "AutoSizeCommentsBroadphase.h"
 #include "AutoSizeCommentsCacheFile.h"
+#include "AutoSizeCommentsContainment.h"
+#include "AutoSizeCommentsHighlight.h"
 #include "AutoSizeCommentsMacros.h"
 #include "AutoSizeCommentsNodeChangeData.h"
+#include "AutoSizeCommentsSpatialIndex.h"
 
 enum class EASCResizingMode : uint8;
 class UEdGraphNode_Comment;
 class SGraphPanel;
+class SAutoSizeCommentsGraphNode;
+class SGraphNode;
+
+/** Geometry of a node widget on the last update pass */
+struct FASCNodeGeometry
+{
+	TWeakPtr<SGraphNode> Widget;
+	FASCVector2 Position;
+	FASCVector2 Size;
+};
+
+/** A node queued for deferred work, every event for the node after the first is coalesced into this entry */
+struct FASCDeferredNode
+{
+	/** Frame the node was last queued on */
+	uint64 Frame = 0;
+
+	int32 NumEvents = 0;
+};
+
+/** Graph events collected during a frame and processed in a single batch on a later frame */
+struct FASCDeferredGraphWork
+{
+	/** Nodes added by the user */
+	TMap<TWeakObjectPtr<UEdGraphNode>, FASCDeferredNode> AddedNodes;
+
+	/** Nodes changed by undo / redo or a finished transaction, whose containing comments need to resize */
+	TMap<TWeakObjectPtr<UEdGraphNode>, FASCDeferredNode> TransactedNodes;
+
+	static void QueueNode(TMap<TWeakObjectPtr<UEdGraphNode>, FASCDeferredNode>& Queue, UEdGraphNode* Node);
+
+	bool IsEmpty() const { return AddedNodes.Num() == 0 && TransactedNodes.Num() == 0; }
+};
 
 struct FASCGraphHandlerData
 {
@@ -16,12 +54,42 @@ struct FASCGraphHandlerData
 	FDelegateHandle OnGraphChangedHandle;
 
 	TMap<FGuid, FASCCommentChangeData> CommentChangeData;
+
+	/** Node fingerprints referenced by the comment change data */
+	FASCNodeChangeStore NodeChangeStore;
 	FASCGraphData GraphCacheData;
 
 	TArray<TWeakObjectPtr<UEdGraphNode_Comment>> InitialComments;
 
 	float LastZoomLevel = -1;
 	EGraphRenderingLOD::Type LastLOD = EGraphRenderingLOD::Type::DefaultDetail;
+
+	bool bPreviousAltDown = false;
+
+	/** Nodes which have been modified since the last update pass (a comment also counts as modified when its contents change) */
+	TSet<TWeakObjectPtr<UEdGraphNode>> ModifiedNodes;
+
+	/** Nodes may have been added or removed, so comments need to check for deleted nodes */
+	bool bCheckForInvalidNodes = true;
+	int32 LastNumGraphNodes = 0;
+
+	FASCCommentContainment CommentContainment;
+
+	/** Geometry of the panel's node widgets (in panel order), compared each frame to find which nodes moved or resized */
+	TArray<FASCNodeGeometry> NodeGeometry;
+
+	FASCBoundsCache BoundsCache;
+
+	FASCCommentBroadphase CommentBroadphase;
+
+	FASCNodeHighlight NodeHighlight;
+
+	FASCDeferredGraphWork DeferredWork;
+
+	/** Lookup for restoring comments from the cache, rebuilt when nodes are added or removed */
+	TMap<FGuid, TWeakObjectPtr<UEdGraphNode>> GuidToNode;
+	int32 GuidToNodeNumGraphNodes = 0;
+	bool bGuidToNodeDirty = true;
 };
 
 struct FASCPendingGraphPurge
@@ -56,11 +124,38 @@ public:
 	bool HasCommentChangeState(UEdGraphNode_Comment* Comment) const;
 	bool HasCommentChanged(UEdGraphNode_Comment* Comment);
 
+	/** Get the comment hierarchy for the graph, rebuilding it if it was invalidated */
+	FASCCommentContainment& GetCommentContainment(UEdGraph* Graph);
+
+	/** Find the comment hierarchy for the graph to keep in sync, null if the graph isn't bound */
+	FASCCommentContainment* FindCommentContainment(UEdGraph* Graph);
+
+	UEdGraphNode* FindNodeByGuid(UEdGraph* Graph, const FGuid& NodeGuid);
+
+	/** Get the sorted comment bounds for the graph, built once per frame */
+	FASCCommentBroadphase& GetCommentBroadphase(UEdGraph* Graph);
+
+	/** Flag the comments containing this node to check for changes on the next update pass */
+	void MarkNodeModified(UEdGraphNode* Node);
+
+	/** Cached bounds of the node (including its comment bubble) */
+	FSlateRect GetNodeBounds(TSharedPtr<SGraphPanel> GraphPanel, UEdGraphNode* Node);
+
+	/** Refresh the cached bounds of the node now and flag its parent comments to resize in the current update pass */
+	void UpdateNodeBounds(SGraphNode& NodeWidget);
+
 	TArray<UEdGraph*> GetActiveGraphs();
 	TArray<TSharedPtr<SGraphPanel>> GetActiveGraphPanels();
 
+	FASCSpatialIndex& GetSpatialIndex(TSharedPtr<SGraphPanel> GraphPanel);
+
 	EGraphRenderingLOD::Type GetGraphLOD(TSharedPtr<SGraphPanel> GraphPanel);
 
+	/** Grey out every node on the graph except for these, only updating the nodes which changed state */
+	void SetNodesRelated(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes);
+	bool UpdateNodesRelated(UEdGraph* Graph, const TArray<UEdGraphNode*>& AddedNodes, const TArray<UEdGraphNode*>& RemovedNodes);
+	void ResetNodesUnrelated(UEdGraph* Graph);
+
 	void ClearUnrelatedNodes();
 
 	void ClearGraphData();
@@ -72,6 +167,11 @@ private:
 
 	TArray<TWeakPtr<SGraphPanel>> ActiveGraphPanels;
 
+	TMap<TWeakPtr<SGraphPanel>, FASCSpatialIndex> SpatialIndices;
+
+	/** Panels with a spatial index, grouped by the graph they display */
+	TMap<TWeakObjectPtr<UEdGraph>, TArray<TWeakPtr<SGraphPanel>>> SpatialIndexPanels;
+
 #if ASC_UE_VERSION_OR_LATER(5, 0)
 	FTSTicker::FDelegateHandle TickDelegateHandle;
 #else
@@ -84,6 +184,16 @@ private:
 
 	bool Tick(float DeltaTime);
 
+	void UpdateComments();
+
+	/** Process the graph events queued on previous frames */
+	void ProcessDeferredWork();
+
+	void UpdateGraphComments(UEdGraph* Graph, const TArray<TSharedPtr<SAutoSizeCommentsGraphNode>>& Comments);
+
+	/** Compare the position and desired size of the panel's node widgets against the last frame, refreshing the bounds of the changed nodes */
+	void FindNodeGeometryChanges(TSharedPtr<SGraphPanel> GraphPanel, FASCGraphHandlerData& GraphData, TArray<UEdGraphNode*>& OutChangedNodes);
+
 	void UpdateNodeUnrelatedState();
 
 	void UpdateGraphPurgeTimer();
@@ -100,11 +210,19 @@ private:
 
 	void OnObjectTransacted(UObject* Object, const FTransactionObjectEvent& Event);
 
+	void OnObjectModified(UObject* Object);
+
 	void OnPostGarbageCollect();
 
+	void InvalidateSpatialIndices(UEdGraph* Graph);
+
+	/** Spatial indices of the panels displaying the graph */
+	TArray<FASCSpatialIndex*, TInlineAllocator<2>> FindSpatialIndices(UEdGraph* Graph);
+
 	void SaveSizeCache();
 
-	void UpdateContainingComments(TWeakObjectPtr<UEdGraphNode> Node);
+	/** Resize the comments containing any of the nodes */
+	void UpdateContainingComments(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes);
 
 	void RefreshGraphVisualRefresh(TWeakPtr<SGraphPanel> GraphPanel);
 
@@ -19,6 +19,13 @@ class UEdGraphNode_Comment;
 
 DECLARE_STATS_GROUP(TEXT("AutoSizeComments"), STATGROUP_AutoSizeComments, STATCAT_Advanced);
 
+/** A node moved along with the comment during group movement */
+struct FASCDragNode
+{
+	TWeakObjectPtr<UEdGraphNode> Node;
+	TSharedRef<SNodePanel::SNode> Widget;
+};
+
 /**
  * Auto resizing comment node
  */
@@ -38,14 +45,10 @@ enum class EASCAnchorPoint : uint8
 class SAutoSizeCommentsGraphNode final : public SGraphNode
 {
 public:
-	uint8 TwoPassResizeDelay = 0;
-
 	bool bIsDragging = false;
 
 	bool bIsMoving = false;
 
-	bool bPreviousAltDown = false;
-
 	/** Variables related to resizing the comment box by dragging anchor corner points */
 	FASCVector2 DragSize;
 	bool bUserIsDragging = false;
@@ -56,6 +59,40 @@ public:
 
 	bool bRequireUpdate = false;
 
+	/** Set by the graph handler when a node inside the comment has been modified (reactive resizing) */
+	bool bNodesModified = true;
+
+	/** Set by the graph handler when a node inside the comment has moved or changed size on screen (reactive resizing) */
+	bool bGeometryChanged = false;
+
+	/** The comment's geometry was last changed by its own resize, which the graph handler should not react to */
+	bool IsGeometryFromResize() const;
+
+	/** Set when the comment becomes empty or is dropped, an empty comment is then placed clear of the other comments */
+	bool bRequestEmptyPlacement = true;
+	bool bWasEmpty = false;
+
+	/** Animation of an empty comment sliding to its new position, finished when the alpha reaches 1 */
+	FASCVector2 PlacementStart;
+	FASCVector2 PlacementTarget;
+	float PlacementAlpha = 1.0f;
+
+	/** Position and size set by the last resize to fit */
+	FASCVector2 ResizedPos;
+	FASCVector2 ResizedSize;
+	bool bHasResizedGeometry = false;
+
+	/** Unselected nodes under the comment and their widgets, resolved once when a drag starts */
+	TArray<FASCDragNode> DragClosure;
+	bool bHasDragClosure = false;
+
+	void BuildDragClosure();
+
+	/** Set when a material comment has moved, the material is dirtied once the drag or transaction ends */
+	bool bPendingMaterialDirty = false;
+
+	void FlushMaterialDirty();
+
 	virtual void MoveTo(const FASCVector2& NewPosition, FNodeSet& NodeFilter, bool bMarkDirty = true) override;
 
 public:
@@ -113,6 +150,12 @@ public:
 	void ResizeToFit();
 	void ResizeToFit_Impl();
 
+	/** Resizing and collision logic, run for all comments of a graph in FAutoSizeCommentGraphHandler::UpdateGraphComments */
+	void UpdateComment(const TSet<UEdGraphNode*>* GraphNodes, bool bIsAltDown);
+
+	/** Comments only get updated by the graph handler while their widget is being ticked (the graph is visible) */
+	bool ShouldUpdateComment() const;
+
 	void ApplyHeaderStyle();
 	void ApplyPresetStyle(const FPresetCommentStyle& Style);
 	void ApplyPresetButtonStyle(const FPresetCommentButtonStyle& Style);
@@ -168,6 +211,7 @@ private:
 	float GetWrapAt() const;
 
 	void MoveEmptyCommentBoxes();
+	void UpdatePlacementAnimation(float DeltaTime);
 
 	void CreateCommentControls();
 	void CreateColorControls();
@@ -209,6 +253,12 @@ private:
 
 	bool bInitialized = false;
 
+	/** Frame we were last ticked by slate */
+	uint64 LastTickFrame = 0;
+
+	/** Panel we are registered with in FASCState */
+	TWeakPtr<SGraphPanel> RegisteredPanel;
+
 	// TODO: Look into resize transaction perhaps requires the EdGraphNode_Comment to have UPROPERTY() for NodesUnderComment
 	// TSharedPtr<FScopedTransaction> ResizeTransaction;
 
@@ -234,7 +284,6 @@ public:
 	/** Util functions */
 	FSlateRect GetBoundsForNodesInside();
 	FSlateRect GetNodeBounds(UEdGraphNode* Node);
-	TSet<TSharedPtr<SAutoSizeCommentsGraphNode>> GetOtherCommentNodes();
 	TArray<UEdGraphNode_Comment*> GetParentComments() const;
 	void UpdateExistingCommentNodes(const TArray<UEdGraphNode_Comment*>* OldParentComments, const TArray<UObject*>* OldCommentContains);
 	void UpdateExistingCommentNodes();
@@ -246,7 +295,7 @@ public:
 	TArray<UEdGraphNode*> GetNodesUnderComment() const;
 	bool AddAllNodesUnderComment(const TArray<UObject*>& Nodes, const bool bUpdateExistingComments = true);
 	bool IsValidGraphPanel(TSharedPtr<SGraphPanel> GraphPanel);
-	void RemoveInvalidNodes();
+	void RemoveInvalidNodes(const TSet<UEdGraphNode*>& GraphNodes);
 
 	EASCAnchorPoint GetAnchorPoint(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) const;
 
@@ -268,7 +317,6 @@ public:
 
 	bool CanAddNode(const TSharedPtr<SGraphNode> OtherGraphNode, const bool bIgnoreKnots = false) const;
 	bool CanAddNode(const UObject* Node, const bool bIgnoreKnots = false) const;
-	void OnAltReleased();
 
 	static bool IsCommentNode(UObject* Object);
 	static bool IsNotCommentNode(UObject* Object) { return !IsCommentNode(Object); }
@@ -284,6 +332,26 @@ public:
 	void SetNodesRelated(const TArray<UEdGraphNode*>& Nodes, bool bIncludeSelf = true);
 	void ResetNodesUnrelated();
 
+	/** Highlight the nodes under the comment on the next tick, so fast mouse events only query once per frame */
+	void RequestRelatedNodesQuery(ECommentCollisionMethod CollisionMethod);
+
+	/** Query the nodes under the comment, only checking the strip swept by the edge when a single edge has moved */
+	void UpdateRelatedNodesQuery(ECommentCollisionMethod CollisionMethod);
+
+	void ClearRelatedNodesQuery();
+
+	/** Bounds used to query the nodes under the comment */
+	FSlateRect GetQueryBounds() const;
+
+	TOptional<ECommentCollisionMethod> PendingRelatedQuery;
+
+	/** Result of the last related nodes query */
+	TSet<TWeakObjectPtr<UEdGraphNode>> RelatedQueryNodes;
+	FSlateRect RelatedQueryBounds;
+	ECommentCollisionMethod RelatedQueryMethod{};
+	uint32 RelatedQueryHighlightGeneration = 0;
+	bool bHasRelatedQuery = false;
+
 	bool IsExistingComment() const;
 
 	EASCResizingMode GetResizingMode() const;
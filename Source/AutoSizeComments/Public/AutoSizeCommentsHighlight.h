@@ -0,0 +1,44 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UEdGraph;
+class UEdGraphNode;
+
+/**
+ * Tracks the nodes highlighted on a graph while comments are selected, resized or alt-dragged.
+ * Only the nodes entering or leaving the related set are flipped with SetNodeUnrelated.
+ */
+struct FASCNodeHighlight
+{
+	/** Grey out every node on the graph except for these */
+	void SetRelatedNodes(UEdGraph* Graph, const TArray<UEdGraphNode*>& Nodes);
+
+	/** Flip only the nodes which entered or left the related set, false if the highlight needs a full update instead */
+	bool UpdateRelatedNodes(UEdGraph* Graph, const TArray<UEdGraphNode*>& AddedNodes, const TArray<UEdGraphNode*>& RemovedNodes);
+
+	/** Clear the unrelated state of every node on the graph */
+	void Reset(UEdGraph* Graph);
+
+	/** Nodes added to the graph while active are greyed out, as they are not in the related set */
+	void OnNodesAdded(const TSet<const UEdGraphNode*>& Nodes);
+
+	/** The graph changed without saying which nodes, the next update refreshes every node */
+	void Invalidate() { bRequiresFullUpdate = true; }
+
+	bool IsActive() const { return bActive; }
+
+	/** Changes whenever the related set is replaced or reset, so incremental updates can tell if someone else has changed it */
+	uint32 GetGeneration() const { return Generation; }
+
+private:
+	TSet<TWeakObjectPtr<UEdGraphNode>> RelatedNodes;
+
+	bool bActive = false;
+
+	uint32 Generation = 0;
+
+	bool bRequiresFullUpdate = false;
+};
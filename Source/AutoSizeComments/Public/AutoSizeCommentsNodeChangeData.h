@@ -8,27 +8,6 @@
 class UEdGraphPin;
 class UEdGraphNode_Comment;
 
-struct FASCPinChangeData
-{
-	bool bPinLinked;
-	bool bPinHidden;
-	FString PinValue;
-	FText PinTextValue;
-	FText PinLabel;
-	FString PinObject;
-
-	FASCPinChangeData() = default;
-
-	void UpdatePin(UEdGraphPin* Pin);
-
-	bool HasPinChanged(UEdGraphPin* Pin);
-
-	FString GetPinDefaultObjectName(UEdGraphPin* Pin) const;
-
-	FText GetPinLabel(UEdGraphPin* Pin) const;
-};
-
-
 /**
  * @brief Node can change by:
  *		- Pin being linked
@@ -37,37 +16,54 @@ struct FASCPinChangeData
  *		- Expanding the node (see print string)
  *		- Node title changing
  *		- Comment bubble pinned
+ *
+ * These are reduced to a fingerprint which is only recomputed after the node has been marked dirty
  */
 class FASCNodeChangeData
 {
-	TMap<FGuid, FASCPinChangeData> PinChangeData;
-	bool bCommentBubblePinned;
-	FString NodeTitle;
-	bool AdvancedPinDisplay;
-	ENodeEnabledState NodeEnabledState;
-	int32 NodeX;
-	int32 NodeY;
-	FName DelegateFunctionName;
+	uint64 Fingerprint = 0;
+	bool bDirty = true;
 
 public:
 	FASCNodeChangeData() = default;
 
-	void UpdateNode(UEdGraphNode* Node);
+	uint64 GetFingerprint(UEdGraphNode* Node);
+
+	/** The node has been modified, recompute the fingerprint on the next check */
+	void MarkDirty() { bDirty = true; }
+
+	static uint64 ComputeFingerprint(UEdGraphNode* Node);
 
-	bool HasNodeChanged(UEdGraphNode* Node);
+private:
+	static void HashPin(uint64& Hash, UEdGraphPin* Pin);
+};
+
+/** Fingerprints of the nodes on a graph, shared by every comment on the graph */
+class FASCNodeChangeStore
+{
+	TMap<TWeakObjectPtr<UEdGraphNode>, FASCNodeChangeData> NodeChangeData;
+
+public:
+	uint64 GetFingerprint(UEdGraphNode* Node);
+
+	void MarkNodeDirty(UEdGraphNode* Node);
+
+	void RemoveInvalidNodes();
 };
 
 class FASCCommentChangeData
 {
 	FString NodeComment;
-	TMap<TWeakObjectPtr<UEdGraphNode>, FASCNodeChangeData> NodeChangeData;
+
+	/** Fingerprint of each node under the comment when the comment last updated */
+	TMap<TWeakObjectPtr<UEdGraphNode>, uint64> NodeFingerprints;
 
 public:
 	FASCCommentChangeData() = default;
 
-	void UpdateComment(UEdGraphNode_Comment* Comment);
+	void UpdateComment(UEdGraphNode_Comment* Comment, FASCNodeChangeStore& NodeStore);
 
-	bool HasCommentChanged(UEdGraphNode_Comment* Comment);
+	bool HasCommentChanged(UEdGraphNode_Comment* Comment, FASCNodeChangeStore& NodeStore);
 
 	void DebugPrint();
 };
\ No newline at end of file
@@ -29,6 +29,16 @@ enum class EASCCacheSaveLocation : uint8
 	Project UMETA(DisplayName = "Project"),
 };
 
+UENUM()
+enum class EASCCacheFileFormat : uint8
+{
+	/** Human-readable json file, useful for diffing and debugging */
+	Json UMETA(DisplayName = "Json"),
+
+	/** Compact binary file, faster to load and save for large projects */
+	Binary UMETA(DisplayName = "Binary"),
+};
+
 UENUM()
 enum class EASCResizingMode : uint8
 {
@@ -217,8 +227,8 @@ public:
     UPROPERTY(EditAnywhere, config, Category = Misc, meta = (EditCondition = "ResizingMode == EASCResizingMode::Disabled", EditConditionHides))
     bool ResizeToFitWhenDisabled;
 
-	/** In reactive mode, run a 2nd resize so that the title is correctly calculated */
-	UPROPERTY(EditAnywhere, config, Category = Misc, meta = (EditCondition = "ResizingMode == EASCResizingMode::Reactive"))
+	/** Deprecated, reactive comments now resize on the frame the size of their nodes changes */
+	UPROPERTY(EditAnywhere, config, Category = "Misc|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Reactive comments resize when the geometry of their nodes changes"))
 	bool bUseTwoPassResize;
 
 	/** Determines when to insert newly created nodes into existing comments */
@@ -261,8 +271,12 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = Misc)
 	bool bMoveEmptyCommentBoxes;
 
-	/** The speed at which empty comment boxes move */
-	UPROPERTY(EditAnywhere, config, Category = Misc)
+	/** Seconds taken to slide an empty comment box clear of other comment boxes, 0 moves it instantly */
+	UPROPERTY(EditAnywhere, config, Category = Misc, meta = (EditCondition = "bMoveEmptyCommentBoxes", ClampMin = 0, UIMax = 1))
+	float EmptyCommentBoxAnimationTime;
+
+	/** Deprecated, empty comment boxes are placed in a single step */
+	UPROPERTY(EditAnywhere, config, Category = "Misc|Deprecated", meta = (DeprecatedProperty, DeprecationMessage = "Empty comment boxes are placed in a single step, see EmptyCommentBoxAnimationTime"))
 	float EmptyCommentBoxSpeed;
 
 	/** Choose cache save method: as an external file or inside the package's metadata */
@@ -273,6 +287,10 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = CommentCache, meta = (EditCondition = "CacheSaveMethod == EASCCacheSaveMethod::File", EditConditionHides))
 	EASCCacheSaveLocation CacheSaveLocation;
 
+	/** Choose the format of the cache file. An existing json cache will be migrated when switching to binary */
+	UPROPERTY(EditAnywhere, config, Category = CommentCache, meta = (EditCondition = "CacheSaveMethod == EASCCacheSaveMethod::File", EditConditionHides))
+	EASCCacheFileFormat CacheFileFormat;
+
 	/** If enabled, nodes will be saved to file when the graph is saved */
 	UPROPERTY(EditAnywhere, config, Category = CommentCache)
 	bool bSaveCommentDataOnSavingGraph;
@@ -281,6 +299,14 @@ public:
 	UPROPERTY(EditAnywhere, config, Category = CommentCache)
 	bool bSaveCommentDataOnExit;
 
+	/** If enabled, changes to comments are appended to a journal file every frame so they are not lost if the editor closes unexpectedly */
+	UPROPERTY(EditAnywhere, config, Category = CommentCache, meta = (EditCondition = "CacheSaveMethod == EASCCacheSaveMethod::File", EditConditionHides))
+	bool bWriteCacheJournal;
+
+	/** When a package's journal grows past this size (in KB) it is folded into the package's cache file */
+	UPROPERTY(EditAnywhere, config, Category = CommentCache, AdvancedDisplay, meta = (EditCondition = "bWriteCacheJournal", ClampMin = 1))
+	int32 CacheJournalCompactionSize;
+
 	/** If enabled, cache file JSON text will be made more human-readable, but increases file size */
 	UPROPERTY(EditAnywhere, config, Category = CommentCache, AdvancedDisplay)
 	bool bPrettyPrintCommentCacheJSON;
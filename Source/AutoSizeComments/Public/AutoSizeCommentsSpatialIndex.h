@@ -0,0 +1,60 @@
+// Copyright fpwong. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AutoSizeCommentsMacros.h"
+
+enum class ECommentCollisionMethod : uint8;
+class SGraphPanel;
+class SGraphNode;
+class UEdGraphNode;
+
+/**
+ * Uniform grid of the node widgets on a graph panel, used for collision queries against comment bounds.
+ * Nodes which are modified are re-bucketed on the next query, the grid is rebuilt when the panel's nodes change.
+ */
+struct FASCSpatialIndex
+{
+	static constexpr float CellSize = 512.0f;
+
+	void QueryNodes(TSharedPtr<SGraphPanel> GraphPanel, const FSlateRect& Bounds, ECommentCollisionMethod CollisionMethod, TArray<TSharedPtr<SGraphNode>>& OutNodes);
+
+	void MarkNodeDirty(UEdGraphNode* Node);
+
+	/** Test a single node against the bounds, as QueryNodes would */
+	static bool IsNodeColliding(const SGraphNode& NodeWidget, const FSlateRect& Bounds, ECommentCollisionMethod CollisionMethod);
+
+	void Invalidate() { bRequiresRebuild = true; }
+
+	/** The node widgets were compared against their last geometry this frame, with changed nodes marked dirty */
+	void MarkGeometrySynced() { LastGeometrySyncFrame = GFrameCounter; }
+
+private:
+	struct FEntry
+	{
+		TWeakPtr<SGraphNode> Widget;
+		FIntRect Cells;
+	};
+
+	TArray<FEntry> Entries;
+	TMap<TWeakObjectPtr<UEdGraphNode>, int32> NodeToEntry;
+	TMap<FIntPoint, TArray<int32>> Grid;
+
+	TSet<TWeakObjectPtr<UEdGraphNode>> DirtyNodes;
+	bool bRequiresRebuild = true;
+
+	/** Without a geometry scan (outside reactive mode), every entry is re-bucketed once per frame instead */
+	uint64 LastGeometrySyncFrame = 0;
+
+	void Rebuild(TSharedPtr<SGraphPanel> GraphPanel);
+
+	void UpdateDirtyNodes();
+	void UpdateAllNodes();
+
+	void AddToGrid(int32 EntryIndex);
+	void RemoveFromGrid(int32 EntryIndex);
+
+	static FSlateRect GetNodeBounds(const SGraphNode& NodeWidget);
+	static FIntRect GetCellsForBounds(const FSlateRect& Bounds);
+};
@@ -4,6 +4,7 @@
 
 class UEdGraphNode_Comment;
 class SAutoSizeCommentsGraphNode;
+class SGraphPanel;
 
 struct FASCState
 {
@@ -19,4 +20,16 @@ struct FASCState
 
 	TSharedPtr<SAutoSizeCommentsGraphNode> GetASCComment(const UEdGraphNode_Comment* Comment);
 	bool HasRegisteredComment(UEdGraphNode_Comment* Comment);
+
+	/** Comment widgets are added when their owner panel is set and removed when they are destroyed */
+	void AddPanelComment(TSharedPtr<SGraphPanel> Panel, TSharedRef<SAutoSizeCommentsGraphNode> ASCComment);
+	void RemovePanelComment(TSharedPtr<SGraphPanel> Panel, const SAutoSizeCommentsGraphNode* ASCComment);
+
+	/** Comment widgets owned by the panel in the order they were added, a widget is replaced when the panel recreates it */
+	TConstArrayView<TWeakPtr<SAutoSizeCommentsGraphNode>> GetPanelComments(TSharedPtr<SGraphPanel> Panel) const;
+
+private:
+	TMap<TWeakPtr<SGraphPanel>, TArray<TWeakPtr<SAutoSizeCommentsGraphNode>>> PanelComments;
+
+	void RemoveInvalidPanels();
 };
@@ -10,10 +10,12 @@ class UEdGraphNode_Comment;
 class SGraphPin;
 class SGraphPanel;
 class SGraphNode;
+struct FWidgetPath;
 
 struct FASCUtils
 {
 	static TArray<UEdGraphNode_Comment*> GetContainingCommentNodes(const TArray<UEdGraphNode_Comment*>& Comments, UEdGraphNode* Node);
+	static TArray<UEdGraphNode_Comment*> GetContainingCommentNodes(UEdGraphNode* Node);
 	static TArray<UEdGraphNode*> GetNodesUnderComment(UEdGraphNode_Comment* Comment);
 
 	static TArray<UEdGraphPin*> GetPinsByDirection(const UEdGraphNode* Node, EEdGraphPinDirection Direction = EGPD_MAX);
@@ -31,6 +33,9 @@ struct FASCUtils
 
 	static TSharedPtr<SGraphPin> GetHoveredGraphPin(TSharedPtr<SGraphPanel> GraphPanel);
 
+	/** Find the pin under the cursor from the widget path, only the pins of the node under the cursor are checked */
+	static TSharedPtr<SGraphPin> GetHoveredGraphPin(TSharedPtr<SGraphPanel> GraphPanel, const FWidgetPath& WidgetPath);
+
 	static TArray<UEdGraphNode_Comment*> GetSelectedComments(TSharedPtr<SGraphPanel> GraphPanel);
 	static TSet<UEdGraphNode*> GetSelectedNodes(TSharedPtr<SGraphPanel> GraphPanel, bool bExpandComments);
 